@@ -0,0 +1,71 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	AllocationCounter.cpp
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Counts the heap allocations made by the calling thread.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+* Other files	:
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*								#INCLUDES AND #CONSTANTS								*
+****************************************************************************************/
+
+#include "AllocationCounter.h"
+
+#include <cstdlib>
+#include <new>
+
+// One counter per thread, no synchronisation on the allocation path
+static thread_local long long t_allocations = 0;
+
+/****************************************************************************************
+*									MEMBER FUNCTIONS									*
+****************************************************************************************/
+
+//public member functions
+
+long long AllocationCounter::count() {
+	return t_allocations;
+}
+
+bool AllocationCounter::enabled() {
+#ifdef WHITEROBOT_COUNT_ALLOCATIONS
+	return true;
+#else
+	return false;
+#endif
+}
+
+/****************************************************************************************
+*							REPLACEMENT ALLOCATION FUNCTIONS							*
+****************************************************************************************/
+
+#ifdef WHITEROBOT_COUNT_ALLOCATIONS
+
+// The array and nothrow forms of the library call these two
+
+void* operator new(std::size_t size) {
+	++t_allocations;
+	void* memory = std::malloc(size == 0 ? 1 : size);
+	if (memory == nullptr) {
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+
+void operator delete(void* memory) noexcept {
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+	std::free(memory);
+}
+
+#endif
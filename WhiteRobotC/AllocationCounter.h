@@ -0,0 +1,58 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	AllocationCounter.h
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Counts the heap allocations made by the calling thread.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+* Other files	:
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*							#GUARDS #INCLUDES AND #CONSTANTS							*
+****************************************************************************************/
+
+#pragma once
+
+/****************************************************************************************
+*									CLASS DECLARATION									*
+****************************************************************************************/
+
+// Built with WHITEROBOT_COUNT_ALLOCATIONS (CMake option COUNT_ALLOCATIONS), AllocationCounter.cpp
+// replaces the global operator new and delete and every allocation through new (and so through
+// the standard containers) is counted on its thread. Otherwise the counts stay at 0
+class AllocationCounter
+{
+
+public:
+
+	//constructors
+
+	AllocationCounter() : m_start(count()) {}
+
+
+	//Getters
+
+	// Allocations of the calling thread since the construction
+	long long allocations() const { return count() - m_start; }
+
+
+	//public member functions
+
+	// Allocations of the calling thread since it started
+	static long long count();
+
+	// Whether this build replaces operator new and counts
+	static bool enabled();
+
+private:
+
+	//private variable members
+
+	long long m_start; // count() at the construction
+};
@@ -0,0 +1,253 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	BatchBacktester.cpp
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Runs a batch of White Robots with different parameters through the
+*					data together, one bar at a time.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+* Other files	:	WhiteRobot.cpp holds the single robot version (RunStrategySummary).
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*								#INCLUDES AND #CONSTANTS								*
+****************************************************************************************/
+
+#include "BatchBacktester.h"
+
+#include <iostream>
+#include <algorithm>
+
+/****************************************************************************************
+*									MEMBER FUNCTIONS									*
+****************************************************************************************/
+
+//Getters
+
+StrategyStatistics BatchBacktester::getStatistics(size_t robot) const {
+	return m_statistics[robot];
+}
+
+
+//public member functions
+
+void BatchBacktester::run(const vector<RobotParameters>& parameters, double intialCash) {
+	reset(parameters, intialCash);
+	if (parameters.empty()) {
+		return;
+	}
+
+	const int points = static_cast<int>(m_data->prices.size());
+	int first = *min_element(m_start.begin(), m_start.end());
+	for (int point = first; point < points; ++point) {
+		readIndicators(point);
+		stepRobots(point, point == points - 1);
+		valuePositions(m_data->prices[point]);
+		if (m_pruning.enabled() && point % m_pruning.checkpointPoints == 0 && point < points - 1) {
+			pruneRobots(point);
+		}
+	}
+
+	for (size_t i = 0; i < size(); ++i) {
+		if (m_statistics[i].pruned_point == 0) {
+			m_statistics[i].final_portfolio_value = m_portfolio_value[i];
+		}
+	}
+}
+
+
+//private member functions
+
+void BatchBacktester::reset(const vector<RobotParameters>& parameters, double intialCash) {
+	const size_t robots = parameters.size();
+	const int points = static_cast<int>(m_data->prices.size());
+
+	m_parameters = parameters;
+	m_start.assign(robots, points);
+	m_groups.assign(72, vector<int>());
+	m_averageWindows.clear();
+	m_slopeWindows.clear();
+
+	for (size_t i = 0; i < robots; ++i) {
+		const RobotParameters& p = parameters[i];
+		if (p.maPointsS_long <= 1 || p.maPointsM_long <= 1 || p.maPointsL_long <= 1 || p.maPointsS_short <= 1 ||
+			p.maPointsM_short <= 1 || p.maPointsL_short <= 1 || p.slopePoints <= 1) {
+			cout << " Strategy Impossible to execute" << endl;
+			continue;
+		}
+		m_start[i] = max({ p.maPointsS_long, p.maPointsM_long, p.maPointsL_long, p.maPointsS_short, p.maPointsM_short,
+			p.maPointsL_short, p.slopePoints });
+		m_averageWindows.insert(m_averageWindows.end(), { p.maPointsS_long, p.maPointsM_long, p.maPointsL_long,
+			p.maPointsS_short, p.maPointsM_short, p.maPointsL_short });
+		m_slopeWindows.push_back(p.slopePoints);
+		m_groups[8 * WhiteStrategy::kernelModeLong(p.mode_long) + WhiteStrategy::kernelModeShort(p.mode_short)].push_back(static_cast<int>(i));
+	}
+
+	// Sorted, so readIndicators stops at the first window longer than the data seen so far
+	sort(m_averageWindows.begin(), m_averageWindows.end());
+	m_averageWindows.erase(unique(m_averageWindows.begin(), m_averageWindows.end()), m_averageWindows.end());
+	sort(m_slopeWindows.begin(), m_slopeWindows.end());
+	m_slopeWindows.erase(unique(m_slopeWindows.begin(), m_slopeWindows.end()), m_slopeWindows.end());
+	m_average.assign(m_averageWindows.empty() ? 0 : m_averageWindows.back() + 1, 0);
+	m_slope.assign(m_slopeWindows.empty() ? 0 : m_slopeWindows.back() + 1, 0);
+
+	// RunStrategySummary pads the histories with zeros before the first tradable point
+	m_previous_long.assign(robots, MovingAverages{ 0, 0, 0 });
+	m_previous_short.assign(robots, MovingAverages{ 0, 0, 0 });
+	m_state.assign(robots, 1);
+	m_order.assign(robots, 0);
+	m_current_cash.assign(robots, intialCash);
+	m_cfd_units.assign(robots, 0);
+	m_last_trade_investment.assign(robots, 1);
+	m_portfolio_value.assign(robots, intialCash);
+	m_peak.assign(robots, intialCash);
+
+	StrategyStatistics empty = {};
+	empty.initial_portfolio_value = intialCash;
+	empty.final_portfolio_value = intialCash;
+	m_statistics.assign(robots, empty);
+}
+
+void BatchBacktester::readIndicators(int point) {
+	const IndicatorTable& indicators = m_data->indicators;
+	// A robot starts at its longest window, so it only reads windows up to point
+	for (int window : m_averageWindows) {
+		if (window > point) {
+			break;
+		}
+		m_average[window] = indicators.average(point, window);
+	}
+	for (int window : m_slopeWindows) {
+		if (window > point) {
+			break;
+		}
+		m_slope[window] = indicators.slope(point, window);
+	}
+}
+
+void BatchBacktester::stepRobots(int point, bool last_point) {
+	static const array<GroupStep, 72> steps = groupSteps(make_integer_sequence<int, 72>());
+	for (size_t pair = 0; pair < m_groups.size(); ++pair) {
+		if (!m_groups[pair].empty()) {
+			(this->*steps[pair])(point, last_point, m_groups[pair]);
+		}
+	}
+}
+
+template <int ModeLong, int ModeShort>
+void BatchBacktester::stepGroup(int point, bool last_point, const vector<int>& robots) {
+	// Sides that can open a trade and the averages their modes compare the small one with
+	const bool trades_long = ModeLong >= 1 && ModeLong <= 7;
+	const bool trades_short = ModeShort >= 1 && ModeShort <= 7;
+	const bool long_medium = trades_long && ModeLong != 4, long_large = trades_long && ModeLong != 7;
+	const bool short_medium = trades_short && ModeShort != 4, short_large = trades_short && ModeShort != 7;
+	if (ModeLong == 0 || (!trades_long && !trades_short)) {
+		// Never leaves state 1, the robots keep their cash
+		return;
+	}
+
+	const IndicatorTable& indicators = m_data->indicators;
+	const double price = m_data->prices[point];
+
+	for (int i : robots) {
+		if (point < m_start[i]) {
+			continue;
+		}
+		const RobotParameters& p = m_parameters[i];
+		StrategyStatistics& statistics = m_statistics[i];
+
+		// Same settling as WhiteRobot::readSignals, for the averages in use
+		MovingAverages ma_long = { 0, 0, 0 }, ma_short = { 0, 0, 0 };
+		if (trades_long) {
+			ma_long.small = m_average[p.maPointsS_long];
+			if (long_medium) {
+				ma_long.medium = m_average[p.maPointsM_long];
+				indicators.settleTie(point, p.maPointsS_long, ma_long.small, p.maPointsM_long, ma_long.medium);
+			}
+			if (long_large) {
+				ma_long.large = m_average[p.maPointsL_long];
+				indicators.settleTie(point, p.maPointsS_long, ma_long.small, p.maPointsL_long, ma_long.large);
+			}
+		}
+		if (trades_short) {
+			ma_short.small = m_average[p.maPointsS_short];
+			if (short_medium) {
+				ma_short.medium = m_average[p.maPointsM_short];
+				indicators.settleTie(point, p.maPointsS_short, ma_short.small, p.maPointsM_short, ma_short.medium);
+			}
+			if (short_large) {
+				ma_short.large = m_average[p.maPointsL_short];
+				indicators.settleTie(point, p.maPointsS_short, ma_short.small, p.maPointsL_short, ma_short.large);
+			}
+		}
+
+		int state = m_state[i];
+		// Out of a trade only the last point stops, without counting a stop loss
+		bool invested = state == 3 || state == 4 || state == 6 || state == 7;
+		if ((invested || last_point) && ws.stopLossReached(m_last_trade_investment[i], m_portfolio_value[i], state,
+			statistics.long_stop_loss, p.stopLoss, statistics.short_stop_loss, last_point)) {
+			// Slop loss limit reached in the previous point
+			state = 1;
+		}
+		else {
+			// The trend is only read in state 1
+			double slope = 0;
+			if (state == 1) {
+				slope = m_slope[p.slopePoints];
+				indicators.settleThreshold(point, p.slopePoints, slope, p.slopeMin_long);
+				indicators.settleThreshold(point, p.slopePoints, slope, -p.slopeMin_short);
+			}
+			state = WhiteStrategy::nextState<ModeLong, ModeShort>(state, slope, ma_long, m_previous_long[i], ma_short, m_previous_short[i],
+				p.slopeMin_long, p.slopeMin_short);
+		}
+		m_state[i] = state;
+
+		int order = ws.stateAnalyser(state);
+		if (order != m_order[i]) {
+			// Opens or closes a trade, the portfolio value is recomputed by valuePositions
+			double trade_profit;
+			ws.executeOrder(order, m_order[i], price, m_current_cash[i], m_last_trade_investment[i], m_cfd_units[i],
+				statistics.long_trades, statistics.short_trades, statistics.long_trades_profit, statistics.good_long_trades,
+				statistics.short_trades_profit, statistics.good_short_trades, trade_profit);
+			m_order[i] = order;
+		}
+
+		m_previous_long[i] = ma_long;
+		m_previous_short[i] = ma_short;
+	}
+}
+
+template <int... Pairs>
+array<BatchBacktester::GroupStep, 72> BatchBacktester::groupSteps(integer_sequence<int, Pairs...>) {
+	return {{ &BatchBacktester::stepGroup<Pairs / 8, Pairs % 8>... }};
+}
+
+void BatchBacktester::valuePositions(double price) {
+	// Same expressions as WhiteStrategy::executeOrder, robots not started yet hold their cash
+	const int* order = m_order.data();
+	const double* cash = m_current_cash.data();
+	const double* units = m_cfd_units.data();
+	const double* investment = m_last_trade_investment.data();
+	double* value = m_portfolio_value.data();
+	for (size_t i = 0; i < size(); ++i) {
+		double long_value = cash[i] + units[i] * price;
+		double short_value = cash[i] + 2 * investment[i] - units[i] * price;
+		value[i] = order[i] == 1 ? long_value : (order[i] == -1 ? short_value : cash[i]);
+	}
+}
+
+void BatchBacktester::pruneRobots(int point) {
+	const int points = static_cast<int>(m_data->prices.size());
+	for (size_t i = 0; i < size(); ++i) {
+		if (m_start[i] < point && m_pruning.prunes(m_portfolio_value[i], m_peak[i])) {
+			m_statistics[i].final_portfolio_value = m_portfolio_value[i];
+			m_statistics[i].pruned_point = point;
+			m_start[i] = points;
+		}
+	}
+}
@@ -0,0 +1,121 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	BatchBacktester.h
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Runs a batch of White Robots with different parameters through the
+*					data together, one bar at a time.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+* Other files	:	WhiteRobot.h holds the single robot version (RunStrategySummary).
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*							#GUARDS #INCLUDES AND #CONSTANTS							*
+****************************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <array>
+#include <memory>
+#include <utility>
+#include "WhiteRobot.h"
+#include "WhiteStrategy.h"
+using namespace std;
+
+/****************************************************************************************
+*									CLASS DECLARATION									*
+****************************************************************************************/
+
+// Same simulation as WhiteRobot::RunStrategySummary for every robot of the batch, with the
+// same results. The state of the robots is kept as one array per variable, and every bar
+// the averages and slopes the batch needs are looked up once and shared by the robots
+// using the same window. The robots are grouped by their pair of modes, and every group is
+// stepped by a version of the loop compiled for its modes, which only reads the averages
+// the modes react to. The positions are valued in a separate branch free loop over the
+// whole batch, only robots whose order changes go through WhiteStrategy::executeOrder.
+class BatchBacktester
+{
+
+public:
+
+	//constructors
+
+	explicit BatchBacktester(shared_ptr<const MarketData> data) : m_data(data) {}
+
+
+	//Getters
+
+	size_t size() const { return m_state.size(); }
+
+	StrategyStatistics getStatistics(size_t robot) const;
+
+	// Stops the robots rule prunes, off by default
+	void setPruning(const PruningRule& rule) { m_pruning = rule; }
+
+
+	//public member functions
+
+	// Simulates every parameter set from intialCash, results through getStatistics
+	void run(const vector<RobotParameters>& parameters, double intialCash);
+
+private:
+
+	//private member functions
+
+	void reset(const vector<RobotParameters>& parameters, double intialCash);
+
+	// Fills m_average and m_slope for the windows of the batch at point
+	void readIndicators(int point);
+
+	// Signals, state machine and order changes of the active robots at point
+	void stepRobots(int point, bool last_point);
+
+	typedef void (BatchBacktester::*GroupStep)(int point, bool last_point, const vector<int>& robots);
+
+	// stepRobots for the robots of one pair of WhiteStrategy kernel modes
+	template <int ModeLong, int ModeShort>
+	void stepGroup(int point, bool last_point, const vector<int>& robots);
+
+	// stepGroup of every pair, at 8 * ModeLong + ModeShort
+	template <int... Pairs>
+	static array<GroupStep, 72> groupSteps(integer_sequence<int, Pairs...>);
+
+	// Portfolio value of every robot at price
+	void valuePositions(double price);
+
+	// Stops the robots past their first point the pruning rule prunes at point
+	void pruneRobots(int point);
+
+	//private variable members
+
+	shared_ptr<const MarketData> m_data; // Dataset shared with the robots of the sweep
+
+	vector<RobotParameters> m_parameters; // Parameters of every robot
+	vector<int> m_start; // First point of every robot, past the data if it cannot run or was pruned
+	vector<vector<int>> m_groups; // Robots of every pair of kernel modes, as groupSteps
+
+	vector<int> m_averageWindows; // Distinct moving average windows of the batch
+	vector<int> m_slopeWindows; // Distinct slope windows of the batch
+	vector<double> m_average; // Average at the current point, by window
+	vector<double> m_slope; // Slope at the current point, by window
+
+	vector<MovingAverages> m_previous_long; // Long averages of the previous point
+	vector<MovingAverages> m_previous_short; // Short averages of the previous point
+	vector<int> m_state; // State of the state machine
+	vector<int> m_order; // Order signal of the last point
+	vector<double> m_current_cash; // Cash not invested
+	vector<double> m_cfd_units; // CFD units held
+	vector<double> m_last_trade_investment; // Cash put in the open or last trade
+	vector<double> m_portfolio_value; // Portfolio value at the current point
+	vector<StrategyStatistics> m_statistics; // Trade counters and portfolio values
+	PruningRule m_pruning; // Early stop of the robots
+	vector<double> m_peak; // Highest portfolio value at the checks of the pruning rule
+
+	WhiteStrategy ws; // Brain of the robots
+};
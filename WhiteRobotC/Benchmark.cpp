@@ -0,0 +1,1017 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	Benchmark.cpp
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Timings of the robot building blocks against their reference versions.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+* Other files	:
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*								#INCLUDES AND #CONSTANTS								*
+****************************************************************************************/
+
+#include "Benchmark.h"
+#include "AllocationCounter.h"
+#include "BranchMissCounter.h"
+
+#include <cmath>
+#include <array>
+#include <algorithm>
+#include <cstdio>
+
+/****************************************************************************************
+*									MEMBER FUNCTIONS									*
+****************************************************************************************/
+
+//public member functions
+
+void Benchmark::movingAverages() {
+	const vector<double>& prices = m_series.prices();
+	const int sizes[] = { 14, 60, 400 };
+	Signal_Generator generate;
+	IndicatorTable table;
+	table.build(prices);
+
+	cout << endl << "Moving averages (ns per bar):" << endl;
+	for (int windowSize : sizes) {
+		int bars = static_cast<int>(prices.size()) - windowSize;
+		if (bars <= 0) {
+			continue;
+		}
+
+		// Reference: the window copy RunStrategy used to make, passed by value
+		vector<double> reference(bars);
+		auto start = chrono::steady_clock::now();
+		for (int i = 0; i < bars; i++) {
+			auto it = prices.begin() + windowSize + i;
+			vector<double> prices_window(it - windowSize + 1, it + 1);
+			reference[i] = generate.movingAverage(prices_window, windowSize);
+		}
+		double referenceTime = elapsed(start);
+
+		vector<double> lookups(bars);
+		start = chrono::steady_clock::now();
+		for (int i = 0; i < bars; i++) {
+			lookups[i] = table.average(windowSize + i, windowSize);
+		}
+		double tableTime = elapsed(start);
+
+		double maxError = 0;
+		for (int i = 0; i < bars; i++) {
+			maxError = max(maxError, fabs(lookups[i] - reference[i]) / fabs(reference[i]));
+		}
+
+		cout << " window " << setw(4) << windowSize << ": reference " << setw(8) << static_cast<long long>(1e9 * referenceTime / bars)
+			<< "  table " << setw(5) << static_cast<long long>(1e9 * tableTime / bars)
+			<< "  speedup x" << static_cast<long long>(tableTime > 0 ? referenceTime / tableTime : 0)
+			<< "  max relative difference " << scientific << setprecision(1) << maxError << defaultfloat << endl;
+		check(maxError <= 1e-12, "averages of window " + to_string(windowSize) + " further than 1e-12 from movingAverage");
+	}
+}
+
+void Benchmark::movingSlopes() {
+	const vector<double>& prices = m_series.prices();
+	const int sizes[] = { 50, 300, 500 };
+	Signal_Generator generate;
+	IndicatorTable table;
+	table.build(prices);
+
+	cout << endl << "Moving slopes (ns per bar):" << endl;
+	for (int windowSize : sizes) {
+		int bars = static_cast<int>(prices.size()) - windowSize;
+		if (bars <= 0) {
+			continue;
+		}
+
+		// Reference: window copy + vector movingSlope, as RunStrategy used to do
+		vector<double> reference(bars);
+		auto start = chrono::steady_clock::now();
+		for (int i = 0; i < bars; i++) {
+			auto it = prices.begin() + windowSize + i;
+			vector<double> prices_window(it - windowSize + 1, it + 1);
+			reference[i] = generate.movingSlope(prices_window, windowSize);
+		}
+		double referenceTime = elapsed(start);
+
+		vector<double> lookups(bars);
+		start = chrono::steady_clock::now();
+		for (int i = 0; i < bars; i++) {
+			lookups[i] = table.slope(windowSize + i, windowSize);
+		}
+		double tableTime = elapsed(start);
+
+		// Error relative to the mean price, the scale the rounding grows with
+		double maxError = 0;
+		for (int i = 0; i < bars; i++) {
+			maxError = max(maxError, fabs(lookups[i] - reference[i]) / fabs(prices[windowSize + i]));
+		}
+
+		cout << " window " << setw(4) << windowSize << ": reference " << setw(8) << static_cast<long long>(1e9 * referenceTime / bars)
+			<< "  table " << setw(5) << static_cast<long long>(1e9 * tableTime / bars)
+			<< "  speedup x" << static_cast<long long>(tableTime > 0 ? referenceTime / tableTime : 0)
+			<< "  max difference / price " << scientific << setprecision(1) << maxError << defaultfloat << endl;
+		check(maxError <= 1e-12, "slopes of window " + to_string(windowSize) + " further than 1e-12 times the price from movingSlope");
+	}
+}
+
+void Benchmark::indicatorTable() {
+	const vector<double>& prices = m_series.prices();
+	const int windowSize = 300;
+	int bars = static_cast<int>(prices.size()) - windowSize;
+	if (bars <= 0) {
+		return;
+	}
+
+	IndicatorTable table;
+	auto start = chrono::steady_clock::now();
+	table.build(prices);
+	double buildTime = elapsed(start);
+
+	// Lookups at every bar, as one robot of a sweep does
+	vector<double> averages(bars), slopes(bars);
+	start = chrono::steady_clock::now();
+	for (int i = 0; i < bars; i++) {
+		averages[i] = table.average(windowSize + i, windowSize);
+	}
+	double averageTime = elapsed(start);
+	start = chrono::steady_clock::now();
+	for (int i = 0; i < bars; i++) {
+		slopes[i] = table.slope(windowSize + i, windowSize);
+	}
+	double slopeTime = elapsed(start);
+
+	double maxError = 0;
+	for (int i = 0; i < bars; i++) {
+		double price = fabs(prices[windowSize + i]);
+		maxError = max(maxError, fabs(averages[i] - table.exactAverage(windowSize + i, windowSize)) / price);
+		maxError = max(maxError, fabs(slopes[i] - table.exactSlope(windowSize + i, windowSize)) / price);
+	}
+
+	cout << endl << "Indicator table (ns per bar):" << endl;
+	cout << " build " << static_cast<long long>(1e9 * buildTime / prices.size())
+		<< "  average lookup " << static_cast<long long>(1e9 * averageTime / bars)
+		<< "  slope lookup " << static_cast<long long>(1e9 * slopeTime / bars)
+		<< "  max difference / price " << scientific << setprecision(1) << maxError << defaultfloat << endl;
+}
+
+void Benchmark::stateMachine() {
+	WhiteStrategy ws;
+
+	// Every state, mode pair, trend and crossing of both sides: the small average at 0 and
+	// each of the others below, above, crossing down, crossing up or equal to it
+	const double levels[5][2] = { { -1, -1 }, { 1, 1 }, { 1, -1 }, { -1, 1 }, { 0, 0 } };
+	const double slopes[] = { -1, -0.5, 0, 0.5, 1 };
+	long long cases = 0, differences = 0, kernelDifferences = 0;
+	for (int state = 0; state <= 8; state++) {
+		for (int mode_long = -1; mode_long <= 8; mode_long++) {
+			for (int mode_short = -1; mode_short <= 8; mode_short++) {
+				WhiteStrategy::StateKernel kernel = WhiteStrategy::stateKernel(mode_long, mode_short);
+				for (double slope : slopes) {
+					for (int crossing = 0; crossing < 25 * 25; crossing++) {
+						const double* m_long = levels[crossing % 5];
+						const double* l_long = levels[crossing / 5 % 5];
+						const double* m_short = levels[crossing / 25 % 5];
+						const double* l_short = levels[crossing / 125];
+						MovingAverages current_long = { 0, m_long[0], l_long[0] }, previous_long = { 0, m_long[1], l_long[1] };
+						MovingAverages current_short = { 0, m_short[0], l_short[0] }, previous_short = { 0, m_short[1], l_short[1] };
+
+						int table = ws.nextState(state, slope, current_long, previous_long, current_short, previous_short, 0.5, mode_long, 0.5, mode_short);
+						int branching = ws.branchingNextState(state, slope, current_long, previous_long, current_short, previous_short, 0.5, mode_long, 0.5, mode_short);
+						int specialised = kernel(state, slope, current_long, previous_long, current_short, previous_short, 0.5, 0.5);
+						++cases;
+						differences += table != branching;
+						kernelDifferences += specialised != branching;
+					}
+				}
+			}
+		}
+	}
+
+	check(differences == 0, "the transition table differs from branchingNextState in " + to_string(differences) + " cases");
+	check(kernelDifferences == 0, "the mode kernels differ from branchingNextState in " + to_string(kernelDifferences) + " cases");
+
+	// All 64 mode pairs stepped over the data, the modes vary from robot to robot as in a sweep
+	const int windows[] = { 9, 21, 50, 200 };
+	const int points = static_cast<int>(m_series.size());
+	if (points <= windows[3]) {
+		return;
+	}
+	IndicatorTable indicators;
+	indicators.build(m_series.prices());
+	vector<MovingAverages> averages;
+	vector<double> trend;
+	for (int point = windows[3]; point < points; point++) {
+		averages.push_back({ indicators.average(point, windows[0]), indicators.average(point, windows[1]), indicators.average(point, windows[2]) });
+		trend.push_back(indicators.slope(point, windows[3]));
+	}
+	const double slopeMin = 0.5 * indicators.exactAverage(points - 1, windows[3]) / windows[3];
+	const int bars = static_cast<int>(averages.size());
+
+	auto run = [&](bool table) {
+		vector<int> states(64, 1);
+		for (int i = 1; i < bars; i++) {
+			for (int robot = 0; robot < 64; robot++) {
+				states[robot] = table
+					? ws.nextState(states[robot], trend[i], averages[i], averages[i - 1], averages[i], averages[i - 1], slopeMin, robot % 8, slopeMin, robot / 8)
+					: ws.branchingNextState(states[robot], trend[i], averages[i], averages[i - 1], averages[i], averages[i - 1], slopeMin, robot % 8, slopeMin, robot / 8);
+			}
+		}
+		return states;
+	};
+
+	// The two versions alternate, which runs first swapping every repeat, and the best of
+	// each is kept so a frequency change or a preemption does not favour either
+	const int repeats = 7;
+	BranchMissCounter counter;
+	double bestTime[2] = { 1e300, 1e300 };
+	long long fewestMisses[2] = { -1, -1 };
+	vector<int> states[2];
+	for (int repeat = 0; repeat < 2 * repeats; repeat++) {
+		const int table = (repeat + repeat / 2) % 2;
+		auto start = chrono::steady_clock::now();
+		counter.start();
+		states[table] = run(table == 1);
+		long long misses = counter.stop();
+		bestTime[table] = min(bestTime[table], elapsed(start));
+		fewestMisses[table] = fewestMisses[table] < 0 ? misses : min(fewestMisses[table], misses);
+	}
+	const vector<int>& branchingStates = states[0];
+	const vector<int>& tableStates = states[1];
+
+	cout << endl << "State machine (per robot and bar, best of " << repeats << " alternated runs):" << endl;
+	cout << fixed << setprecision(2);
+	for (int table = 0; table < 2; table++) {
+		cout << (table == 1 ? " table   " : " if/else ") << 1e9 * bestTime[table] / (64.0 * bars) << " ns  branch misses ";
+		if (counter.enabled()) {
+			cout << fewestMisses[table] / (64.0 * bars) << endl;
+		}
+		else {
+			cout << "not measured" << endl;
+		}
+	}
+	cout << defaultfloat << " exhaustive check: " << differences << " (table) and " << kernelDifferences
+		<< " (mode kernels) of " << cases << " cases differ"
+		<< (tableStates == branchingStates ? "" : ", final states differ") << endl;
+	check(tableStates == branchingStates, "the transition table ends in other states than branchingNextState");
+}
+
+void Benchmark::strategyRuns() {
+	const int runs = 50;
+	WhiteRobot robot;
+	robot.setData(m_series.all());
+
+	// Example parameters of the single robot menu
+	auto start = chrono::steady_clock::now();
+	for (int i = 0; i < runs; i++) {
+		robot.setParameters(14, 21, 40, 0.01, 1, 14, 21, 40, 0.01, 1, 300, 0.05);
+		robot.RunStrategy(1000);
+	}
+	double historyTime = elapsed(start);
+
+	start = chrono::steady_clock::now();
+	for (int i = 0; i < runs; i++) {
+		robot.setParameters(14, 21, 40, 0.01, 1, 14, 21, 40, 0.01, 1, 300, 0.05);
+		robot.RunStrategySummary(1000);
+	}
+	double summaryTime = elapsed(start);
+
+	// The same runs in lockstep, windows varied so the batch reads several of them
+	vector<RobotParameters> parameters;
+	for (int i = 0; i < runs; i++) {
+		RobotParameters p = { 14, 21 + i % 5, 40 + i % 7, 0.01, 1, 14, 21 + i % 3, 40 + i % 11, 0.01, 1, 300 + i, 0.05 };
+		parameters.push_back(p);
+	}
+	BatchBacktester batch(robot.getData());
+	start = chrono::steady_clock::now();
+	batch.run(parameters, 1000);
+	double batchTime = elapsed(start);
+
+	// The summary runs again, one pass for as many stop losses
+	vector<double> stopLosses;
+	for (int i = 0; i < runs; i++) {
+		stopLosses.push_back(0.002 * (i + 1));
+	}
+	start = chrono::steady_clock::now();
+	robot.setParameters(14, 21, 40, 0.01, 1, 14, 21, 40, 0.01, 1, 300, 0.05);
+	robot.RunStrategyStopLosses(1000, stopLosses);
+	double stopLossTime = elapsed(start);
+
+	cout << endl << "Strategy runs (ms per run):" << endl;
+	cout << " RunStrategy " << fixed << setprecision(3) << 1e3 * historyTime / runs
+		<< "  RunStrategySummary " << 1e3 * summaryTime / runs
+		<< "  BatchBacktester " << 1e3 * batchTime / runs
+		<< "  RunStrategyStopLosses " << 1e3 * stopLossTime / runs << defaultfloat << endl;
+
+	vector<ReferenceRuns> references = referenceRuns();
+	int robots = 0, summaryDifferences = 0, sweepDifferences = 0, batchDifferences = 0, eventDifferences = 0, boundedDifferences = 0;
+	int lanes = 0, laneDifferences = 0;
+	size_t boundedPairs = 0;
+	for (const ReferenceRuns& reference : references) {
+		const size_t count = reference.parameters.size();
+		robots += static_cast<int>(count);
+
+		WhiteRobot summary;
+		summary.setData(m_series.view(reference.first, reference.last));
+		for (size_t i = 0; i < count; i++) {
+			summary.setParameters(reference.parameters[i]);
+			summary.RunStrategySummary(1000);
+			summaryDifferences += !sameStatistics(summary.getStatistics(), reference.statistics[i]);
+		}
+
+		// Stop losses unsorted and repeated, from triggering on most trades to never
+		const double stopLosses[] = { 0.05, 0.002, 0.2, 0.01, 0.03, 0.01, 0.0005 };
+		for (size_t i = 0; i < 4 && i < count; i++) {
+			summary.setParameters(reference.parameters[i]);
+			vector<StrategyStatistics> results = summary.RunStrategyStopLosses(1000, vector<double>(begin(stopLosses), end(stopLosses)));
+			for (size_t k = 0; k < results.size(); k++) {
+				RobotParameters p = reference.parameters[i];
+				p.stopLoss = stopLosses[k];
+				summary.setParameters(p);
+				summary.RunStrategy(1000);
+				++lanes;
+				laneDifferences += !sameStatistics(results[k], summary.getStatistics());
+			}
+		}
+
+		// Rows of the sweep menus when they run RunStrategySummary
+		vector<string> expected = referenceRows(reference);
+		WhiteRobot source;
+		source.setData(m_series.view(reference.first, reference.last));
+		const vector<RobotParameters>& parameters = reference.parameters;
+		vector<string> rows = sweepRows([&](const string& fileName) {
+			SweepRunner runner(source, ThreadPool::shared());
+			runner.setEngine(SweepRunner::SUMMARY);
+			runner.run([&parameters](int i) { return parameters[i]; }, static_cast<int>(count), 1000, fileName);
+		});
+		for (size_t i = 0; i < count; i++) {
+			sweepDifferences += i >= rows.size() || rows[i] != expected[i];
+		}
+
+		BatchBacktester lockstep(reference.data);
+		lockstep.run(reference.parameters, 1000);
+		for (size_t i = 0; i < count; i++) {
+			batchDifferences += !sameStatistics(lockstep.getStatistics(i), reference.statistics[i]);
+		}
+
+		EventBacktester events(reference.data);
+		events.run(reference.parameters, 1000);
+
+		// The same window with room for the crossings of a single pair, every robot finds
+		// the crossings of its other pairs dropped and computes them again
+		PriceView view = m_series.view(reference.first, reference.last);
+		shared_ptr<MarketData> bounded = make_shared<MarketData>();
+		bounded->dates.assign(view.times, view.times + view.size);
+		bounded->dateFormat = view.dateFormat;
+		bounded->prices.assign(view.prices, view.prices + view.size);
+		bounded->indicators.build(bounded->prices);
+		bounded->events.build(bounded->prices, bounded->indicators, 1);
+		EventBacktester evicted(bounded);
+		evicted.run(reference.parameters, 1000);
+		boundedPairs = max(boundedPairs, bounded->events.storedPairs());
+
+		for (size_t i = 0; i < count; i++) {
+			eventDifferences += !sameStatistics(events.getStatistics(i), reference.statistics[i]);
+			boundedDifferences += !sameStatistics(evicted.getStatistics(i), reference.statistics[i]);
+		}
+	}
+
+	// The range runs of walk-forward trade as RunStrategySummary on the points from the
+	// largest window before first to last, random windows of every length
+	const int ranges = m_series.size() < 4 * 500 ? 0 : 600;
+	int rangeDifferences = 0;
+	if (ranges > 0) {
+		ParameterRange range;
+		range.lowest = { 2, 10, 15, 0.01, 0, 2, 10, 15, 0.01, 0, 50, 0.01 };
+		range.highest = { 20, 40, 60, 0.05, 7, 20, 40, 60, 0.05, 7, 500, 0.05 };
+		const int size = static_cast<int>(m_series.size());
+		mt19937 rng(11);
+		EventBacktester ranged(robot.getData());
+		WhiteRobot slice;
+		for (int i = 0; i < ranges; i++) {
+			RobotParameters p = GeneticOptimizer::draw(range, rng);
+			const int maxWindow = max({ p.maPointsS_long, p.maPointsM_long, p.maPointsL_long, p.maPointsS_short, p.maPointsM_short,
+				p.maPointsL_short, p.slopePoints });
+			const int first = maxWindow + static_cast<int>(rng() % (size - maxWindow));
+			const int last = first + static_cast<int>(rng() % (size - first));
+			ranged.run({ p }, 1000, first, last);
+
+			slice.setData(m_series.view(first - maxWindow, last + 1));
+			slice.setParameters(p);
+			slice.RunStrategySummary(1000);
+			rangeDifferences += !sameStatistics(ranged.getStatistics(0), slice.getStatistics());
+		}
+	}
+
+	cout << " Robots differing from RunStrategy, of " << robots << ": RunStrategySummary " << summaryDifferences
+		<< " (" << sweepDifferences << " rows in a sweep)  BatchBacktester " << batchDifferences
+		<< "  EventBacktester " << eventDifferences
+		<< " (" << boundedDifferences << " with the crossings of one pair kept)" << endl;
+	cout << " Stop losses differing from RunStrategy, of " << lanes << ": RunStrategyStopLosses " << laneDifferences << endl;
+	cout << " Ranges of EventBacktester differing from RunStrategySummary on the same points, of " << ranges << ": "
+		<< rangeDifferences << endl;
+	check(summaryDifferences == 0, "RunStrategySummary differs from RunStrategy for " + to_string(summaryDifferences) + " robots");
+	check(sweepDifferences == 0, "the RunStrategySummary sweep differs from RunStrategy in " + to_string(sweepDifferences) + " rows");
+	check(batchDifferences == 0, "BatchBacktester differs from RunStrategy for " + to_string(batchDifferences) + " robots");
+	check(eventDifferences == 0, "EventBacktester differs from RunStrategy for " + to_string(eventDifferences) + " robots");
+	check(boundedDifferences == 0, "EventBacktester differs from RunStrategy for " + to_string(boundedDifferences) + " robots once crossings are dropped");
+	check(laneDifferences == 0, "RunStrategyStopLosses differs from RunStrategy for " + to_string(laneDifferences) + " stop losses");
+	check(rangeDifferences == 0, "EventBacktester differs from RunStrategySummary in " + to_string(rangeDifferences) + " ranges");
+	check(boundedPairs == 1, "the bounded EventIndex kept the crossings of " + to_string(boundedPairs) + " pairs");
+}
+
+void Benchmark::allocations() {
+	if (!AllocationCounter::enabled()) {
+		cout << endl << "Heap allocations per simulation: not counted, build with -DCOUNT_ALLOCATIONS=ON" << endl;
+		return;
+	}
+	const int runs = 20;
+	WhiteRobot robot;
+	robot.setData(m_series.all());
+
+	vector<RobotParameters> parameters;
+	for (int i = 0; i < runs; i++) {
+		RobotParameters p = { 14, 21 + i % 5, 40 + i % 7, 0.01, 1 + i % 7, 14, 21 + i % 3, 40 + i % 11, 0.01, 1 + i % 5, 300 + i, 0.05 };
+		parameters.push_back(p);
+	}
+	BatchBacktester batch(robot.getData());
+	EventBacktester events(robot.getData());
+
+	// The first runs size the buffers and cache the crossings. RunStrategy computes its
+	// indicators on the calling thread, submitting chunks to a pool allocates the tasks
+	robot.setParameters(parameters[0]);
+	robot.RunStrategy(1000, nullptr);
+	batch.run(parameters, 1000);
+	events.run(parameters, 1000);
+
+	AllocationCounter history;
+	for (const RobotParameters& p : parameters) {
+		robot.setParameters(p);
+		robot.RunStrategy(1000, nullptr);
+	}
+	long long historyAllocations = history.allocations();
+
+	AllocationCounter summary;
+	for (const RobotParameters& p : parameters) {
+		robot.setParameters(p);
+		robot.RunStrategySummary(1000);
+	}
+	long long summaryAllocations = summary.allocations();
+
+	AllocationCounter lockstep;
+	batch.run(parameters, 1000);
+	long long batchAllocations = lockstep.allocations();
+
+	AllocationCounter eventDriven;
+	events.run(parameters, 1000);
+	long long eventAllocations = eventDriven.allocations();
+
+	cout << endl << "Heap allocations per simulation:" << endl;
+	cout << " RunStrategy " << static_cast<double>(historyAllocations) / runs
+		<< "  RunStrategySummary " << static_cast<double>(summaryAllocations) / runs
+		<< "  BatchBacktester " << static_cast<double>(batchAllocations) / runs
+		<< "  EventBacktester " << static_cast<double>(eventAllocations) / runs << endl;
+
+	// Once the buffers are sized no run may allocate
+	check(historyAllocations == 0, "RunStrategy allocated " + to_string(historyAllocations) + " times");
+	check(summaryAllocations == 0, "RunStrategySummary allocated " + to_string(summaryAllocations) + " times");
+	check(batchAllocations == 0, "BatchBacktester allocated " + to_string(batchAllocations) + " times");
+	check(eventAllocations == 0, "EventBacktester allocated " + to_string(eventAllocations) + " times");
+}
+
+void Benchmark::optimizers() {
+	WhiteRobot robot;
+	robot.setData(m_series.all());
+
+	// Closed ranges of the examples of closedRandomWhite
+	ParameterRange range;
+	range.lowest = { 2, 10, 15, 0.01, 0, 2, 10, 15, 0.01, 0, 50, 0.01 };
+	range.highest = { 20, 40, 60, 0.05, 7, 20, 40, 60, 0.05, 7, 500, 0.05 };
+	const double target = 1000 * (1 + kTargetReturn / 100);
+
+	cout << endl << "Simulations to a " << kTargetReturn << "% return (" << kSearchBudget << " means not found):" << endl;
+	EventBacktester backtester(robot.getData());
+	GeneticOptimizer optimizer(robot, ThreadPool::shared());
+	for (unsigned int seed = 1; seed <= 3; seed++) {
+		// Random search in batches, counted up to the first robot reaching the target
+		mt19937 rng(seed);
+		int randomSimulations = 0;
+		bool found = false;
+		while (randomSimulations < kSearchBudget && !found) {
+			vector<RobotParameters> batch;
+			for (int i = 0; i < 64; i++) {
+				batch.push_back(GeneticOptimizer::draw(range, rng));
+			}
+			backtester.run(batch, 1000);
+			for (size_t i = 0; i < batch.size() && !found && randomSimulations < kSearchBudget; i++) {
+				++randomSimulations;
+				found = backtester.getStatistics(i).final_portfolio_value >= target;
+			}
+		}
+
+		// Whole generations are counted
+		int geneticSimulations = optimizer.run(range, kSearchBudget, kTargetReturn, 1000, seed, "");
+		cout << " seed " << seed << ": random search " << randomSimulations << "  genetic " << geneticSimulations << endl;
+	}
+
+	// A single round is the full sweep. Every search gets a dataset of its own, none finds
+	// the crossings built by another.
+	SweepRunner::Sampler sampler = [range](mt19937& rng) { return GeneticOptimizer::draw(range, rng); };
+	cout << endl << "Successive halving of " << kHalvingRobots << " robots (1 of 4 kept) against the full sweep:" << endl;
+	for (unsigned int seed = 1; seed <= 3; seed++) {
+		WhiteRobot sweepData;
+		sweepData.setData(m_series.all());
+		SuccessiveHalving sweep(sweepData, ThreadPool::shared());
+		auto start = chrono::steady_clock::now();
+		vector<int> ranking = sweep.run(sampler, kHalvingRobots, 1, 4, 1000, seed, "");
+		double sweepTime = elapsed(start);
+
+		// Fewer rounds cost more and keep more of the best robots
+		double halvingTimes[2];
+		int found[2] = { 0, 0 };
+		for (int rounds = 3; rounds >= 2; rounds--) {
+			WhiteRobot halvingData;
+			halvingData.setData(m_series.all());
+			SuccessiveHalving halving(halvingData, ThreadPool::shared());
+			start = chrono::steady_clock::now();
+			vector<int> kept = halving.run(sampler, kHalvingRobots, rounds, 4, 1000, seed, "");
+			halvingTimes[3 - rounds] = elapsed(start);
+
+			// Robots of the top 10 of the full sweep the halving kept
+			for (int i = 0; i < 10; i++) {
+				found[3 - rounds] += find(kept.begin(), kept.end(), ranking[i]) != kept.end();
+			}
+		}
+		cout << " seed " << seed << ": full sweep " << sweepTime << " s  3 rounds " << halvingTimes[0] << " s, top 10 kept "
+			<< found[0] << "  2 rounds " << halvingTimes[1] << " s, top 10 kept " << found[1] << endl;
+	}
+}
+
+void Benchmark::sampling() {
+	// Chi-square of the counts in the kCells x kCells grid of every pair of coordinates,
+	// averaged over the pairs. Independent uniform points give kCells^2 - 1 on average.
+	const int kCells = 8;
+	const int kPoints = 1024;
+	auto evenness = [&](const vector<array<double, HaltonSampler::kDimensions>>& points) {
+		double total = 0;
+		int pairs = 0;
+		for (int x = 0; x < HaltonSampler::kDimensions; x++) {
+			for (int y = x + 1; y < HaltonSampler::kDimensions; y++) {
+				vector<int> counts(kCells * kCells, 0);
+				for (const auto& u : points) {
+					counts[static_cast<int>(u[x] * kCells) * kCells + static_cast<int>(u[y] * kCells)]++;
+				}
+				double expected = static_cast<double>(kPoints) / (kCells * kCells);
+				for (int count : counts) {
+					total += (count - expected) * (count - expected) / expected;
+				}
+				pairs++;
+			}
+		}
+		return total / pairs;
+	};
+
+	cout << endl << "Evenness of " << kPoints << " points over pairs of parameters (chi-square, lower is more even):" << endl;
+	for (unsigned int seed = 1; seed <= 3; seed++) {
+		HaltonSampler halton(seed);
+		mt19937 rng(seed);
+		uniform_real_distribution<double> uniform(0, 1);
+		vector<array<double, HaltonSampler::kDimensions>> quasiRandom(kPoints), random(kPoints);
+		for (int i = 0; i < kPoints; i++) {
+			halton.point(i, quasiRandom[i].data());
+			for (double& coordinate : random[i]) {
+				coordinate = uniform(rng);
+			}
+		}
+		cout << " seed " << seed << ": uniform " << evenness(random) << "  Halton " << evenness(quasiRandom) << endl;
+	}
+
+	// Same ranges as optimizers
+	WhiteRobot robot;
+	robot.setData(m_series.all());
+	ParameterRange range;
+	range.lowest = { 2, 10, 15, 0.01, 0, 2, 10, 15, 0.01, 0, 50, 0.01 };
+	range.highest = { 20, 40, 60, 0.05, 7, 20, 40, 60, 0.05, 7, 500, 0.05 };
+
+	const int robots = 2000;
+	cout << endl << "Best portfolio value of " << robots << " robots in closed ranges:" << endl;
+	EventBacktester backtester(robot.getData());
+	auto best = [&](const vector<RobotParameters>& parameters) {
+		backtester.run(parameters, 1000);
+		double value = 0;
+		for (size_t i = 0; i < backtester.size(); i++) {
+			value = max(value, backtester.getStatistics(i).final_portfolio_value);
+		}
+		return value;
+	};
+	for (unsigned int seed = 1; seed <= 3; seed++) {
+		HaltonSampler halton(seed);
+		vector<RobotParameters> quasiRandom, random;
+		for (int i = 0; i < robots; i++) {
+			seed_seq sequence{ seed, static_cast<unsigned int>(i) };
+			mt19937 rng(sequence);
+			random.push_back(GeneticOptimizer::draw(range, rng));
+			quasiRandom.push_back(halton.draw(range, i));
+		}
+		cout << " seed " << seed << ": uniform " << best(random) << "  Halton " << best(quasiRandom) << endl;
+	}
+
+	// A Halton sweep in two parts, the second resuming where the first ended, against the
+	// whole sweep in one run
+	const int parts[] = { 300, 212 };
+	HaltonSampler halton(5);
+	auto points = [&](int firstPoint) {
+		return SweepRunner::IndexSampler([&halton, &range, firstPoint](int i) { return halton.draw(range, firstPoint + i); });
+	};
+	vector<string> continuous = sweepRows([&](const string& fileName) {
+		SweepRunner runner(robot, ThreadPool::shared());
+		runner.run(points(0), parts[0] + parts[1], 1000, fileName);
+	});
+	vector<string> resumed = sweepRows([&](const string& fileName) {
+		SweepRunner first(robot, ThreadPool::shared());
+		first.run(points(0), parts[0], 1000, fileName);
+		SweepRunner second(robot, ThreadPool::shared());
+		second.run(points(parts[0]), parts[1], 1000, fileName);
+	});
+	int differences = 0;
+	for (size_t i = 0; i < static_cast<size_t>(parts[0] + parts[1]); i++) {
+		differences += i >= continuous.size() || i >= resumed.size() || continuous[i] != resumed[i];
+	}
+	cout << " rows of a Halton sweep resumed after " << parts[0] << " points differing from one run: " << differences << endl;
+	check(differences == 0, "a resumed Halton sweep differs from one run in " + to_string(differences) + " rows");
+}
+
+void Benchmark::pruning() {
+	WhiteRobot robot;
+	robot.setData(m_series.all());
+	ParameterRange range;
+	range.lowest = { 2, 10, 15, 0.01, 0, 2, 10, 15, 0.01, 0, 50, 0.01 };
+	range.highest = { 20, 40, 60, 0.05, 7, 20, 40, 60, 0.05, 7, 500, 0.05 };
+	const int robots = 3000;
+	vector<RobotParameters> parameters;
+	for (int i = 0; i < robots; i++) {
+		seed_seq sequence{ 1u, static_cast<unsigned int>(i) };
+		mt19937 rng(sequence);
+		parameters.push_back(GeneticOptimizer::draw(range, rng));
+	}
+
+	// Checks about every month of H1 bars
+	PruningRule rule;
+	rule.checkpointPoints = 500;
+	rule.minValue = 700;
+	rule.maxDrawdown = 0.3;
+
+	// Crossings built before timing either run
+	EventBacktester full(robot.getData());
+	EventBacktester pruned(robot.getData());
+	pruned.setPruning(rule);
+	full.run(parameters, 1000);
+
+	auto start = chrono::steady_clock::now();
+	full.run(parameters, 1000);
+	double fullTime = elapsed(start);
+	start = chrono::steady_clock::now();
+	pruned.run(parameters, 1000);
+	double prunedTime = elapsed(start);
+
+	// Robots run to the end give the rows of the run without the rule
+	int stopped = 0, keptDifferences = 0;
+	for (size_t i = 0; i < pruned.size(); i++) {
+		StrategyStatistics statistics = pruned.getStatistics(i);
+		stopped += statistics.pruned_point > 0;
+		keptDifferences += statistics.pruned_point == 0 && !sameStatistics(statistics, full.getStatistics(i));
+	}
+
+	// The rule replayed on the portfolio values of RunStrategy stops the first robots where
+	// they were stopped, at the value they were stopped with, and nowhere for the others
+	const int replayed = 300;
+	int stopDifferences = 0;
+	const int size = static_cast<int>(m_series.size());
+	for (int i = 0; i < replayed && i < robots; i++) {
+		const RobotParameters& p = parameters[i];
+		robot.setParameters(p);
+		robot.RunStrategy(1000);
+		const vector<double>& values = robot.getPortfolioValues();
+		const int first = max({ p.maPointsS_long, p.maPointsM_long, p.maPointsL_long, p.maPointsS_short, p.maPointsM_short,
+			p.maPointsL_short, p.slopePoints });
+
+		int stop = 0;
+		double peak = 1000;
+		for (int point = first + 1; point < size - 1 && stop == 0; point++) {
+			if (point % rule.checkpointPoints == 0 && rule.prunes(values[point], peak)) {
+				stop = point;
+			}
+		}
+		StrategyStatistics statistics = pruned.getStatistics(i);
+		stopDifferences += stop != statistics.pruned_point || (stop > 0 && values[stop] != statistics.final_portfolio_value);
+	}
+
+	cout << endl << "Pruning below 700 or 30% under the peak, checked every 500 points, " << robots << " robots:" << endl;
+	cout << " without " << fullTime << " s  with " << prunedTime << " s  (" << stopped << " pruned)" << endl;
+	cout << " rows differing for robots run to the end " << keptDifferences << "  stops differing from the rule replayed on "
+		<< replayed << " robots " << stopDifferences << endl;
+	check(keptDifferences == 0, "pruning changed the rows of " + to_string(keptDifferences) + " robots it did not stop");
+	check(stopDifferences == 0, "the pruned robots and the rule replayed on RunStrategy differ for " + to_string(stopDifferences) + " robots");
+
+	// Robots that never trade keep their initial cash and stop at the first check after their
+	// largest window, before or after point 500, so the cached sweep must not share their rows
+	const int idle = 512;
+	vector<RobotParameters> idleParameters(parameters.begin(), parameters.begin() + idle);
+	for (int i = 0; i < idle; i++) {
+		idleParameters[i].slopePoints = 300 + (i * 37) % 500;
+		if (i % 4 != 0) {
+			idleParameters[i].mode_long = 0;
+		}
+	}
+	PruningRule unreachable;
+	unreachable.checkpointPoints = 500;
+	unreachable.minValue = 2000;
+
+	EventBacktester uncached(robot.getData());
+	uncached.setPruning(unreachable);
+	uncached.run(idleParameters, 1000);
+	vector<string> expected;
+	for (int i = 0; i < idle; i++) {
+		robot.setParameters(idleParameters[i]);
+		robot.setStatistics(uncached.getStatistics(i));
+		ostringstream row;
+		robot.writeSimulation(row);
+		expected.push_back(withoutTime(row.str()));
+	}
+	vector<string> rows = sweepRows([&](const string& fileName) {
+		SweepRunner runner(robot, ThreadPool::shared());
+		runner.setPruning(unreachable);
+		runner.run([&idleParameters](int i) { return idleParameters[i]; }, idle, 1000, fileName);
+	});
+	int idleDifferences = 0;
+	for (int i = 0; i < idle; i++) {
+		idleDifferences += i >= static_cast<int>(rows.size()) || rows[i] != expected[i];
+	}
+
+	cout << " rows of a cached sweep of " << idle << " robots mostly never trading, all pruned below 2000, differing from "
+		<< "uncached runs " << idleDifferences << endl;
+	check(idleDifferences == 0, "the cached sweep with pruning differs from uncached runs for " + to_string(idleDifferences) + " robots");
+}
+
+void Benchmark::writing() {
+	WhiteRobot robot;
+	robot.setData(m_series.all());
+	ParameterRange range;
+	range.lowest = { 2, 10, 15, 0.01, 0, 2, 10, 15, 0.01, 0, 50, 0.01 };
+	range.highest = { 20, 40, 60, 0.05, 7, 20, 40, 60, 0.05, 7, 500, 0.05 };
+	vector<RobotParameters> parameters;
+	for (int i = 0; i < 1000; i++) {
+		seed_seq sequence{ 1u, static_cast<unsigned int>(i) };
+		mt19937 rng(sequence);
+		parameters.push_back(GeneticOptimizer::draw(range, rng));
+	}
+	EventBacktester backtester(robot.getData());
+	backtester.run(parameters, 1000);
+
+	// The rows of the robots over and over, to a scratch file removed at the end
+	const int rows = 100000;
+	const string fileName = "benchmark_rows.csv";
+	cout << endl << "Writing " << rows << " summary rows:" << endl;
+
+	// Both formatters on the robots with their values replaced by negatives, zeros, ties
+	// rounded to even and values past the digit by digit range
+	const double values[] = { 0, -0.0, 1234.565, -1234.565, 0.005, -0.005, 0.125, -0.125, 0.375, 2.675, 1.005, 99.995,
+		-0.004, 0.00005, 0.00125, -0.00015, 1e15 + 0.125, -3e17, 7.5e-5 };
+	int formatDifferences = 0, formatted = 0;
+	{
+		remove(fileName.c_str());
+		SimulationWriter writer(fileName, robot.getData());
+		SimulationWriter::Clock clock;
+		for (size_t v = 0; v < sizeof(values) / sizeof(values[0]); v++) {
+			for (size_t i = 0; i < 20; i++) {
+				RobotParameters p = parameters[i];
+				StrategyStatistics statistics = backtester.getStatistics(i);
+				const double value = values[(v + i) % (sizeof(values) / sizeof(values[0]))];
+				statistics.final_portfolio_value = i % 3 == 0 ? value : statistics.initial_portfolio_value + value;
+				statistics.long_trades_profit = value;
+				statistics.short_trades_profit = -value;
+				statistics.pruned_point = i % 4 == 0 ? static_cast<int>(500 * i) : 0;
+				p.slopeMin_long = value;
+				p.slopeMin_short = -value;
+				p.stopLoss = i % 2 == 0 ? value : p.stopLoss;
+
+				robot.setParameters(p);
+				robot.setStatistics(statistics);
+				ostringstream streamed;
+				robot.writeSimulation(streamed);
+				string row;
+				writer.formatRow(p, statistics, clock.now(), row);
+				formatDifferences += withoutTime(row) != withoutTime(streamed.str());
+				++formatted;
+			}
+		}
+	}
+	cout << " SimulationWriter rows differing from writeSimulation: " << formatDifferences << " of " << formatted << endl;
+	check(formatDifferences == 0, "SimulationWriter::formatRow differs from writeSimulation in " + to_string(formatDifferences) + " rows");
+
+	remove(fileName.c_str());
+	auto start = chrono::steady_clock::now();
+	for (int i = 0; i < rows; i++) {
+		robot.setParameters(parameters[i % parameters.size()]);
+		robot.setStatistics(backtester.getStatistics(i % parameters.size()));
+		robot.saveSimulation(fileName);
+	}
+	double reopening = elapsed(start);
+
+	remove(fileName.c_str());
+	start = chrono::steady_clock::now();
+	{
+		ofstream file_out(fileName, ios_base::app);
+		for (int i = 0; i < rows; i++) {
+			robot.setParameters(parameters[i % parameters.size()]);
+			robot.setStatistics(backtester.getStatistics(i % parameters.size()));
+			robot.writeSimulation(file_out);
+		}
+	}
+	double stream = elapsed(start);
+
+	remove(fileName.c_str());
+	start = chrono::steady_clock::now();
+	{
+		SimulationWriter writer(fileName, robot.getData());
+		SimulationWriter::Clock clock;
+		string batch;
+		for (int i = 0; i < rows; i++) {
+			writer.formatRow(parameters[i % parameters.size()], backtester.getStatistics(i % parameters.size()), clock.now(), batch);
+			if (batch.size() > 64 * 1024) {
+				writer.write(batch);
+				batch.clear();
+			}
+		}
+		writer.write(batch);
+	}
+	double buffered = elapsed(start);
+	remove(fileName.c_str());
+
+	cout << " saveSimulation    " << rows / reopening << " rows/s" << endl;
+	cout << " writeSimulation   " << rows / stream << " rows/s" << endl;
+	cout << " SimulationWriter  " << rows / buffered << " rows/s" << endl;
+}
+
+void Benchmark::sweepThreads() {
+	WhiteRobot robot;
+	robot.setData(m_series.all());
+	ParameterRange range;
+	range.lowest = { 2, 10, 15, 0.01, 0, 2, 10, 15, 0.01, 0, 50, 0.01 };
+	range.highest = { 20, 40, 60, 0.05, 7, 20, 40, 60, 0.05, 7, 500, 0.05 };
+	SweepRunner::Sampler sampler = [range](mt19937& rng) { return GeneticOptimizer::draw(range, rng); };
+
+	// Several jobs per worker, so the workers steal and finish them out of order
+	const int robots = 512;
+	ThreadPool one(1), several(4);
+	const SweepRunner::Engine engines[] = { SweepRunner::EVENTS, SweepRunner::LOCKSTEP, SweepRunner::SUMMARY };
+	const char* names[] = { "EventBacktester", "BatchBacktester", "RunStrategySummary" };
+
+	cout << endl << "Rows of a " << robots << " robot sweep differing between 1 and 4 threads:" << endl;
+	for (int e = 0; e < 3; e++) {
+		vector<string> rows[2];
+		for (int t = 0; t < 2; t++) {
+			rows[t] = sweepRows([&](const string& fileName) {
+				SweepRunner runner(robot, t == 0 ? one : several);
+				runner.setEngine(engines[e]);
+				runner.run(sampler, robots, 1000, 3, fileName);
+			});
+		}
+		int differences = 0;
+		for (size_t i = 0; i < static_cast<size_t>(robots); i++) {
+			differences += i >= rows[0].size() || i >= rows[1].size() || rows[0][i] != rows[1][i];
+		}
+		cout << " " << names[e] << " " << differences << endl;
+		check(differences == 0, string("the ") + names[e] + " sweep differs between 1 and 4 threads in " + to_string(differences) + " rows");
+	}
+}
+
+bool Benchmark::runAll() {
+	cout << endl << "Benchmarks over " << m_series.size() << " bars" << endl;
+	movingAverages();
+	movingSlopes();
+	indicatorTable();
+	stateMachine();
+	strategyRuns();
+	allocations();
+	optimizers();
+	sampling();
+	pruning();
+	writing();
+	sweepThreads();
+
+	if (m_failures > 0) {
+		cout << endl << m_failures << " benchmark checks FAILED" << endl;
+	}
+	else {
+		cout << endl << "All benchmark checks passed" << endl;
+	}
+	return m_failures == 0;
+}
+
+
+//private member functions
+
+vector<Benchmark::ReferenceRuns> Benchmark::referenceRuns() const {
+	// Same ranges as optimizers, every mode pair and stop losses that trigger
+	ParameterRange range;
+	range.lowest = { 2, 10, 15, 0.01, 0, 2, 10, 15, 0.01, 0, 50, 0.01 };
+	range.highest = { 20, 40, 60, 0.05, 7, 20, 40, 60, 0.05, 7, 500, 0.05 };
+
+	vector<ReferenceRuns> references;
+	const size_t size = m_series.size();
+	if (size < 4 * 500) {
+		return references;
+	}
+	mt19937 rng(7);
+	for (int window = 0; window < kReferenceWindows; window++) {
+		// A quarter to three quarters of the series, the first window is all of it
+		ReferenceRuns reference;
+		reference.first = window == 0 ? 0 : rng() % (size / 4);
+		reference.last = window == 0 ? size : reference.first + size / 4 + rng() % (size / 2);
+
+		WhiteRobot robot;
+		robot.setData(m_series.view(reference.first, reference.last));
+		reference.data = robot.getData();
+		for (int i = 0; i < kReferenceRobots; i++) {
+			RobotParameters p = GeneticOptimizer::draw(range, rng);
+			robot.setParameters(p);
+			robot.RunStrategy(1000);
+			reference.parameters.push_back(p);
+			reference.statistics.push_back(robot.getStatistics());
+		}
+		references.push_back(reference);
+	}
+	return references;
+}
+
+bool Benchmark::sameStatistics(const StrategyStatistics& a, const StrategyStatistics& b) {
+	return a.initial_portfolio_value == b.initial_portfolio_value && a.final_portfolio_value == b.final_portfolio_value &&
+		a.long_trades == b.long_trades && a.good_long_trades == b.good_long_trades && a.long_trades_profit == b.long_trades_profit &&
+		a.long_stop_loss == b.long_stop_loss && a.short_trades == b.short_trades && a.good_short_trades == b.good_short_trades &&
+		a.short_trades_profit == b.short_trades_profit && a.short_stop_loss == b.short_stop_loss && a.pruned_point == b.pruned_point;
+}
+
+vector<string> Benchmark::referenceRows(const ReferenceRuns& reference) const {
+	WhiteRobot robot;
+	robot.setData(m_series.view(reference.first, reference.last));
+	vector<string> rows;
+	for (size_t i = 0; i < reference.parameters.size(); i++) {
+		robot.setParameters(reference.parameters[i]);
+		robot.setStatistics(reference.statistics[i]);
+		ostringstream row;
+		robot.writeSimulation(row);
+		rows.push_back(withoutTime(row.str()));
+	}
+	return rows;
+}
+
+vector<string> Benchmark::sweepRows(const function<void(const string& fileName)>& run) {
+	// To a scratch file removed at the end
+	const string fileName = "benchmark_sweep.csv";
+	remove(fileName.c_str());
+
+	ostringstream progress;
+	streambuf* console = cout.rdbuf(progress.rdbuf());
+	try {
+		run(fileName);
+	}
+	catch (...) {
+		cout.rdbuf(console);
+		throw;
+	}
+	cout.rdbuf(console);
+
+	vector<string> rows;
+	ifstream file_in(fileName);
+	string line;
+	while (getline(file_in, line)) {
+		rows.push_back(withoutTime(line + "\n"));
+	}
+	file_in.close();
+	remove(fileName.c_str());
+	return rows;
+}
+
+string Benchmark::withoutTime(const string& row) {
+	size_t comma = row.find(',');
+	return comma == string::npos ? row : row.substr(comma);
+}
+
+double Benchmark::elapsed(chrono::steady_clock::time_point start) {
+	return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+bool Benchmark::check(bool passed, const string& what) {
+	if (!passed) {
+		++m_failures;
+		cout << " CHECK FAILED: " << what << endl;
+	}
+	return passed;
+}
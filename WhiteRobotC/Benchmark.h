@@ -0,0 +1,158 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	Benchmark.h
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Timings of the robot building blocks against their reference versions.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+* Other files	:
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*							#GUARDS #INCLUDES AND #CONSTANTS							*
+****************************************************************************************/
+
+#pragma once
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <functional>
+#include "PriceSeries.h"
+#include "Signal_Generator.h"
+#include "IndicatorTable.h"
+#include "WhiteRobot.h"
+#include "BatchBacktester.h"
+#include "EventBacktester.h"
+#include "GeneticOptimizer.h"
+#include "HaltonSampler.h"
+#include "SimulationWriter.h"
+#include "SuccessiveHalving.h"
+#include "SweepRunner.h"
+#include "ThreadPool.h"
+using namespace std;
+
+/****************************************************************************************
+*									CLASS DECLARATION									*
+****************************************************************************************/
+
+class Benchmark
+{
+
+public:
+
+	//constructors
+
+	explicit Benchmark(const PriceSeries& series) : m_series(series), m_failures(0) {}
+
+
+	//Getters
+
+	// Checks that did not hold in the benchmarks run so far
+	int getFailures() const { return m_failures; }
+
+
+	//public member functions
+
+	// Copied window + Signal_Generator::movingAverage against IndicatorTable::average
+	void movingAverages();
+
+	// Copied window + Signal_Generator::movingSlope against IndicatorTable::slope
+	void movingSlopes();
+
+	// IndicatorTable build pass and per bar lookups
+	void indicatorTable();
+
+	// Transition table and mode kernels of WhiteStrategy::nextState checked case by case
+	// against the if/else version, then table and if/else timed on the 64 mode pairs
+	void stateMachine();
+
+	// Full history RunStrategy against the statistics only RunStrategySummary, a batch of
+	// robots in lockstep and the stop losses of one robot in a single pass, then the results
+	// of the other backtesters checked against RunStrategy
+	void strategyRuns();
+
+	// Heap allocations per simulation of the backtests once their buffers are sized, RunStrategy
+	// with its indicators on the calling thread
+	void allocations();
+
+	// Simulations the closed range random search and the genetic optimizer need to find a
+	// robot returning kTargetReturn percent, and successive halving against the full sweep
+	void optimizers();
+
+	// Evenness of uniform and scrambled Halton draws over the parameters, the best robot each
+	// finds in closed ranges, and a Halton sweep resumed part way against one run
+	void sampling();
+
+	// Event driven sweep with and without a pruning rule stopping losing robots
+	void pruning();
+
+	// Summary rows per second through saveSimulation, one stream and SimulationWriter
+	void writing();
+
+	// Rows of seeded sweeps of every engine on 1 and on 4 threads
+	void sweepThreads();
+
+	// Every benchmark in turn, false if one of their checks did not hold
+	bool runAll();
+
+private:
+
+	// Return the optimizers search for, in percent
+	static constexpr double kTargetReturn = 400;
+
+	// Simulations after which a search gives up
+	static const int kSearchBudget = 20000;
+
+	// Robots of the successive halving and full sweeps compared
+	static const int kHalvingRobots = 3000;
+
+	// Windows of the series and robots per window of the backtester checks
+	static const int kReferenceWindows = 4;
+	static const int kReferenceRobots = 32;
+
+	// Random robots on a window of the data and their RunStrategy statistics, which every
+	// other backtester must reproduce exactly
+	struct ReferenceRuns {
+		size_t first; // First bar of the window in the series
+		size_t last; // One past its last bar
+		shared_ptr<const MarketData> data; // Dataset of the window
+		vector<RobotParameters> parameters;
+		vector<StrategyStatistics> statistics; // RunStrategy of every robot
+	};
+
+	//private member functions
+
+	// kReferenceRobots robots on each of kReferenceWindows windows of the series
+	vector<ReferenceRuns> referenceRuns() const;
+
+	// Every field equal
+	static bool sameStatistics(const StrategyStatistics& a, const StrategyStatistics& b);
+
+	// Rows writeSimulation gives for the robots of reference after RunStrategy
+	vector<string> referenceRows(const ReferenceRuns& reference) const;
+
+	// Rows a sweep writes, in order and without their simulation date. run sweeps into the
+	// file it is given, what the sweep prints is dropped
+	static vector<string> sweepRows(const function<void(const string& fileName)>& run);
+
+	// row without its first column, the simulation date
+	static string withoutTime(const string& row);
+
+	// Seconds elapsed since start
+	static double elapsed(chrono::steady_clock::time_point start);
+
+	// Counts and reports what did not hold, returns passed
+	bool check(bool passed, const string& what);
+
+	//private variable members
+
+	const PriceSeries& m_series; // Loaded dataset used by every benchmark
+	int m_failures; // Checks that did not hold
+};
@@ -0,0 +1,83 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	BranchMissCounter.cpp
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Counts the branch mispredictions of the calling thread.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+* Other files	:
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*								#INCLUDES AND #CONSTANTS								*
+****************************************************************************************/
+
+#include "BranchMissCounter.h"
+
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/****************************************************************************************
+*									MEMBER FUNCTIONS									*
+****************************************************************************************/
+
+//constructors
+
+BranchMissCounter::BranchMissCounter() : m_descriptor(-1) {
+#ifdef __linux__
+	perf_event_attr attributes;
+	memset(&attributes, 0, sizeof(attributes));
+	attributes.type = PERF_TYPE_HARDWARE;
+	attributes.size = sizeof(attributes);
+	attributes.config = PERF_COUNT_HW_BRANCH_MISSES;
+	attributes.disabled = 1;
+	attributes.exclude_kernel = 1;
+	attributes.exclude_hv = 1;
+
+	// This thread on any processor, glibc has no wrapper
+	m_descriptor = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+#endif
+}
+
+BranchMissCounter::~BranchMissCounter() {
+#ifdef __linux__
+	if (m_descriptor >= 0) {
+		close(m_descriptor);
+	}
+#endif
+}
+
+
+//public member functions
+
+void BranchMissCounter::start() {
+#ifdef __linux__
+	if (m_descriptor >= 0) {
+		ioctl(m_descriptor, PERF_EVENT_IOC_RESET, 0);
+		ioctl(m_descriptor, PERF_EVENT_IOC_ENABLE, 0);
+	}
+#endif
+}
+
+long long BranchMissCounter::stop() {
+	long long count = 0;
+#ifdef __linux__
+	if (m_descriptor >= 0) {
+		ioctl(m_descriptor, PERF_EVENT_IOC_DISABLE, 0);
+		if (read(m_descriptor, &count, sizeof(count)) != sizeof(count)) {
+			count = 0;
+		}
+	}
+#endif
+	return count;
+}
@@ -0,0 +1,62 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	BranchMissCounter.h
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Counts the branch mispredictions of the calling thread.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+* Other files	:
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*							#GUARDS #INCLUDES AND #CONSTANTS							*
+****************************************************************************************/
+
+#pragma once
+
+/****************************************************************************************
+*									CLASS DECLARATION									*
+****************************************************************************************/
+
+// On Linux the hardware counter of the thread, in user space, is opened with perf_event_open.
+// Elsewhere, or when the kernel or the processor refuse it (perf_event_paranoid, virtual
+// machines), the counter is not enabled and the counts stay at 0
+class BranchMissCounter
+{
+
+public:
+
+	//constructors
+
+	BranchMissCounter();
+	BranchMissCounter(const BranchMissCounter&) = delete;
+	BranchMissCounter& operator=(const BranchMissCounter&) = delete;
+
+	~BranchMissCounter();
+
+
+	//Getters
+
+	// Whether the counter could be opened
+	bool enabled() const { return m_descriptor >= 0; }
+
+
+	//public member functions
+
+	// Counts from 0
+	void start();
+
+	// Branch mispredictions since start
+	long long stop();
+
+private:
+
+	//private variable members
+
+	int m_descriptor; // Of the perf event, -1 when not enabled
+};
@@ -0,0 +1,263 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	CsvParser.cpp
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	In-place parser for the "time,price" CSV files used by the robot.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+*					- W. D. Clinger: How to Read Floating Point Numbers Accurately.
+*					  PLDI 1990 (exact fast path for short decimal mantissas).
+* Other files	:
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*								#INCLUDES AND #CONSTANTS								*
+****************************************************************************************/
+
+#include "CsvParser.h"
+
+#include <string>
+
+#include <cstring>
+#include <cstdlib>
+#include <cstdint>
+#include <algorithm>
+#include <exception>
+#include "Date.h"
+
+// Powers of ten that are exact in a double
+static const double kPow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+								 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+// Chunks smaller than this are not worth a task switch
+static const std::size_t kMinChunkBytes = 256 * 1024;
+
+// Mantissas below 2^53 convert to double without rounding
+static const std::uint64_t kMaxExactMantissa = 9007199254740992ULL;
+
+/****************************************************************************************
+*									MEMBER FUNCTIONS									*
+****************************************************************************************/
+
+//public member functions
+
+const char* CsvParser::nextLine(const char* first, const char* last) {
+	const char* eol = static_cast<const char*>(memchr(first, '\n', last - first));
+	return eol == nullptr ? last : eol + 1;
+}
+
+std::size_t CsvParser::countLines(const char* first, const char* last) {
+	std::size_t lines = 0;
+	while (first != last) {
+		first = nextLine(first, last);
+		++lines;
+	}
+	return lines;
+}
+
+// Fast path: up to 19 significant digits and 22 decimals, where one IEEE division of two
+// exact doubles is correctly rounded, i.e. bit-identical to stod. Anything else (exponents,
+// hex, inf/nan, long mantissas) falls back to strtod on a bounded copy of the field.
+bool CsvParser::parsePrice(const char* first, const char* last, double& value) {
+	const char* p = first;
+	while (p != last && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\v' || *p == '\f')) {
+		++p;
+	}
+
+	bool negative = false;
+	if (p != last && (*p == '-' || *p == '+')) {
+		negative = (*p == '-');
+		++p;
+	}
+
+	std::uint64_t mantissa = 0;
+	int significant = 0;
+	int decimals = 0;
+	bool digits = false;
+	bool exact = true;
+
+	for (; p != last && *p >= '0' && *p <= '9'; ++p) {
+		digits = true;
+		if (mantissa != 0 || *p != '0') {
+			exact = exact && (++significant <= 19);
+			mantissa = mantissa * 10 + (*p - '0');
+		}
+	}
+	if (p != last && *p == '.') {
+		for (++p; p != last && *p >= '0' && *p <= '9'; ++p) {
+			digits = true;
+			++decimals;
+			if (mantissa != 0 || *p != '0') {
+				exact = exact && (++significant <= 19);
+				mantissa = mantissa * 10 + (*p - '0');
+			}
+		}
+	}
+
+	bool special = p != last && (*p == 'e' || *p == 'E' || *p == 'x' || *p == 'X');
+	if (digits && exact && !special && mantissa <= kMaxExactMantissa && decimals <= 22) {
+		double result = static_cast<double>(mantissa) / kPow10[decimals];
+		value = negative ? -result : result;
+		return true;
+	}
+
+	// Slow path, strtod needs a terminated string
+	char buffer[64];
+	std::string longField;
+	const char* text = buffer;
+	std::size_t length = last - first;
+	if (length < sizeof(buffer)) {
+		memcpy(buffer, first, length);
+		buffer[length] = '\0';
+	}
+	else {
+		longField.assign(first, last);
+		text = longField.c_str();
+	}
+
+	char* end = nullptr;
+	double result = strtod(text, &end);
+	if (end == text) {
+		return false;
+	}
+	value = result;
+	return true;
+}
+
+// Same field rules as WhiteRobot::tokenize: empty fields between commas are skipped
+static inline const char* firstField(const char* first, const char* eol, const char*& fieldEnd) {
+	while (first != eol && *first == ',') {
+		++first;
+	}
+	fieldEnd = static_cast<const char*>(memchr(first, ',', eol - first));
+	return first;
+}
+
+int CsvParser::detectDateFormat(const char* first, const char* last) {
+	const char* next = nextLine(first, last);
+	const char* eol = (next != first && next[-1] == '\n') ? next - 1 : next;
+	const char* dateEnd;
+	const char* date = firstField(first, eol, dateEnd);
+	return Date::detectFormat(date, dateEnd == nullptr ? eol : dateEnd);
+}
+
+std::size_t CsvParser::parseRows(const char* first, const char* last, int dateFormat, std::vector<long long>& times, std::vector<double>& prices, std::size_t& badDates) {
+	std::size_t lines = 0;
+
+	while (first != last) {
+		const char* next = nextLine(first, last);
+		const char* eol = (next[-1] == '\n') ? next - 1 : next;
+		++lines;
+
+		// First field: the date, second field: the price
+		const char* dateEnd;
+		const char* date = firstField(first, eol, dateEnd);
+
+		if (dateEnd != nullptr) {
+			const char* fieldEnd;
+			const char* field = firstField(dateEnd, eol, fieldEnd);
+			if (fieldEnd == nullptr) {
+				fieldEnd = eol;
+			}
+
+			double price;
+			long long time;
+			if (field != eol && parsePrice(field, fieldEnd, price) && price > 0) {
+				if (Date::parseEpoch(date, dateEnd, dateFormat, time)) {
+					times.push_back(time);
+					prices.push_back(price);
+				}
+				else {
+					++badDates;
+				}
+			}
+		}
+		first = next;
+	}
+	return lines;
+}
+
+std::size_t CsvParser::parseRowsParallel(const char* first, const char* last, int dateFormat, std::vector<long long>& times, std::vector<double>& prices, std::size_t& badDates, ThreadPool& pool) {
+	std::size_t bytes = last - first;
+	std::size_t chunks = std::min(pool.size(), bytes / kMinChunkBytes + 1);
+
+	if (chunks <= 1) {
+		// One exact reservation instead of the vector growth steps
+		std::size_t lines = countLines(first, last);
+		times.reserve(times.size() + lines);
+		prices.reserve(prices.size() + lines);
+		return parseRows(first, last, dateFormat, times, prices, badDates);
+	}
+
+	// Chunk k starts at the first line beginning at or after k * bytes / chunks
+	std::vector<const char*> bounds(chunks + 1);
+	bounds[0] = first;
+	bounds[chunks] = last;
+	for (std::size_t k = 1; k < chunks; ++k) {
+		const char* split = std::max(first + bytes / chunks * k, bounds[k - 1]);
+		bounds[k] = (split == first || split == last) ? split : nextLine(split - 1, last);
+	}
+
+	struct Chunk
+	{
+		std::vector<long long> times;
+		std::vector<double> prices;
+		std::size_t badDates = 0;
+		std::size_t lines = 0;
+	};
+	std::vector<Chunk> parsed(chunks);
+	std::vector<std::future<void>> done;
+	done.reserve(chunks);
+
+	// The tasks write into parsed and read bounds, so every submitted one finishes before a failure is rethrown
+	std::exception_ptr failure;
+	try {
+		for (std::size_t k = 0; k < chunks; ++k) {
+			done.push_back(pool.submit([&parsed, &bounds, k, dateFormat]() {
+				Chunk& chunk = parsed[k];
+				std::size_t lines = countLines(bounds[k], bounds[k + 1]);
+				chunk.times.reserve(lines);
+				chunk.prices.reserve(lines);
+				chunk.lines = parseRows(bounds[k], bounds[k + 1], dateFormat, chunk.times, chunk.prices, chunk.badDates);
+			}));
+		}
+	}
+	catch (...) {
+		failure = std::current_exception();
+	}
+	for (auto& task : done) {
+		try {
+			task.get();
+		}
+		catch (...) {
+			if (!failure) {
+				failure = std::current_exception();
+			}
+		}
+	}
+	if (failure) {
+		std::rethrow_exception(failure);
+	}
+
+	std::size_t lines = 0;
+	std::size_t rows = 0;
+	for (auto& chunk : parsed) {
+		rows += chunk.prices.size();
+	}
+
+	// Stitch the columns back in file order
+	times.reserve(times.size() + rows);
+	prices.reserve(prices.size() + rows);
+	for (auto& chunk : parsed) {
+		times.insert(times.end(), chunk.times.begin(), chunk.times.end());
+		prices.insert(prices.end(), chunk.prices.begin(), chunk.prices.end());
+		badDates += chunk.badDates;
+		lines += chunk.lines;
+	}
+	return lines;
+}
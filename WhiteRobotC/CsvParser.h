@@ -0,0 +1,58 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	CsvParser.h
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	In-place parser for the "time,price" CSV files used by the robot.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+*					- W. D. Clinger: How to Read Floating Point Numbers Accurately.
+*					  PLDI 1990 (exact fast path for short decimal mantissas).
+* Other files	:
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*							#GUARDS #INCLUDES AND #CONSTANTS							*
+****************************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include "ThreadPool.h"
+
+/****************************************************************************************
+*									CLASS DECLARATION									*
+****************************************************************************************/
+
+class CsvParser
+{
+
+public:
+
+	//public member functions
+
+	// Returns the first byte of the line after the one starting at first
+	static const char* nextLine(const char* first, const char* last);
+
+	// Number of lines in [first, last), counting a last line without '\n'
+	static std::size_t countLines(const char* first, const char* last);
+
+	// Parses a price with the same result as stod, false if there is no number
+	static bool parsePrice(const char* first, const char* last, double& value);
+
+	// Date::Format of the first field of the first line in [first, last)
+	static int detectDateFormat(const char* first, const char* last);
+
+	// Parses every "date,price" line in [first, last) appending the epoch seconds and the positive
+	// prices, returns the number of lines read and counts the rows dropped for an invalid date
+	static std::size_t parseRows(const char* first, const char* last, int dateFormat, std::vector<long long>& times, std::vector<double>& prices, std::size_t& badDates);
+
+	// Same as parseRows, splitting [first, last) at line boundaries into one chunk per pool worker,
+	// the chunks are parsed concurrently and their columns appended in file order
+	static std::size_t parseRowsParallel(const char* first, const char* last, int dateFormat, std::vector<long long>& times, std::vector<double>& prices, std::size_t& badDates, ThreadPool& pool);
+};
@@ -4,6 +4,8 @@
 
 #include "Date.h"
 
+#include <cstring>
+
 Date::Date(std::string userinput)
 {
     std::stringstream test(userinput);
@@ -37,4 +39,179 @@ std::string Date::reformat_date()
         }
     }
     return year + '-' +month + '-' + day + " "+ seglist[1];
-}
\ No newline at end of file
+}
+
+// Fixed-width layouts of the data files: 'd' is a digit, any other character must match
+struct DateLayout
+{
+    const char* pattern;
+    std::size_t length;
+    int year, month, day, hour, minute, second; // Offset of each field, -1 when absent
+};
+
+static const DateLayout kLayouts[] = {
+    { "", 0, -1, -1, -1, -1, -1, -1 },                      // UNKNOWN
+    { "dd/dd/dddd dd:dd", 16, 6, 3, 0, 11, 14, -1 },        // DMY_HM: 29/09/2003 09:00
+    { "dddd-dd-dd dd:dd:dd", 19, 0, 5, 8, 11, 14, 17 }      // ISO_HMS: 2003-03-21 18:00:00
+};
+
+// True if the text has exactly the shape of the layout, without an early exit per character
+static inline bool matchesLayout(const DateLayout& layout, const char* first, const char* last)
+{
+    if (static_cast<std::size_t>(last - first) != layout.length) {
+        return false;
+    }
+    unsigned bad = 0;
+    for (std::size_t i = 0; i < layout.length; ++i) {
+        unsigned digit = static_cast<unsigned>(static_cast<unsigned char>(first[i])) - '0';
+        bad |= layout.pattern[i] == 'd' ? static_cast<unsigned>(digit > 9) : static_cast<unsigned>(first[i] != layout.pattern[i]);
+    }
+    return bad == 0;
+}
+
+// Value of the two digits at offset, 0 for an absent field
+static inline int twoDigits(const char* p, int offset)
+{
+    return offset < 0 ? 0 : (p[offset] - '0') * 10 + (p[offset + 1] - '0');
+}
+
+// Writes value as exactly width zero padded digits
+static inline void writeDigits(char* p, int value, int width)
+{
+    for (int i = width - 1; i >= 0; --i) {
+        p[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+}
+
+// Number of days of a month in the proleptic Gregorian calendar
+static inline int daysInMonth(int year, int month)
+{
+    static const int days[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    return days[month - 1] + (month == 2 && leap);
+}
+
+// The two layouts have different lengths, so the length picks the candidate
+int Date::detectFormat(const char* first, const char* last)
+{
+    for (int format = DMY_HM; format <= ISO_HMS; ++format) {
+        if (matchesLayout(kLayouts[format], first, last)) {
+            return format;
+        }
+    }
+    return UNKNOWN;
+}
+
+// Parses a date of the given layout into seconds since 1970-01-01 00:00
+bool Date::parseEpoch(const char* first, const char* last, int format, long long& epoch)
+{
+    if (format <= UNKNOWN || format > ISO_HMS || !matchesLayout(kLayouts[format], first, last)) {
+        return false;
+    }
+
+    const DateLayout& layout = kLayouts[format];
+    int year = twoDigits(first, layout.year) * 100 + twoDigits(first, layout.year + 2);
+    int month = twoDigits(first, layout.month);
+    int day = twoDigits(first, layout.day);
+    int hour = twoDigits(first, layout.hour);
+    int minute = twoDigits(first, layout.minute);
+    int second = twoDigits(first, layout.second);
+
+    if (static_cast<unsigned>(month - 1) > 11) {
+        return false;
+    }
+    bool invalid = (static_cast<unsigned>(day - 1) >= static_cast<unsigned>(daysInMonth(year, month))) | (hour > 23) | (minute > 59) | (second > 59);
+    if (invalid) {
+        return false;
+    }
+
+    epoch = daysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+    return true;
+}
+
+// Writes the epoch back in the layout it was read from (ISO for an unknown layout)
+std::string Date::formatEpoch(long long epoch, int format)
+{
+    long long days = epoch / 86400;
+    long long seconds = epoch % 86400;
+    if (seconds < 0) {
+        seconds += 86400;
+        --days;
+    }
+    int year, month, day;
+    civilFromDays(days, year, month, day);
+
+    const DateLayout& layout = kLayouts[format == DMY_HM ? DMY_HM : ISO_HMS];
+    char text[20];
+    memcpy(text, layout.pattern, layout.length);
+    writeDigits(text + layout.year, year, 4);
+    writeDigits(text + layout.month, month, 2);
+    writeDigits(text + layout.day, day, 2);
+    writeDigits(text + layout.hour, static_cast<int>(seconds / 3600), 2);
+    writeDigits(text + layout.minute, static_cast<int>(seconds / 60 % 60), 2);
+    if (layout.second >= 0) {
+        writeDigits(text + layout.second, static_cast<int>(seconds % 60), 2);
+    }
+    return std::string(text, layout.length);
+}
+
+// Splits the text in digit groups: year first when the first group has four digits
+bool Date::parseUserDate(const std::string& text, long long& epoch)
+{
+    int fields[6] = { 0, 0, 0, 0, 0, 0 };
+    int count = 0;
+    std::size_t firstWidth = 0;
+    for (std::size_t i = 0; i < text.size() && count < 6; ) {
+        if (text[i] < '0' || text[i] > '9') {
+            ++i;
+            continue;
+        }
+        std::size_t start = i;
+        int value = 0;
+        for (; i < text.size() && text[i] >= '0' && text[i] <= '9' && i - start < 4; ++i) {
+            value = value * 10 + (text[i] - '0');
+        }
+        if (count == 0) {
+            firstWidth = i - start;
+        }
+        fields[count++] = value;
+    }
+    if (count < 3) {
+        return false;
+    }
+
+    int year = firstWidth == 4 ? fields[0] : fields[2];
+    int month = fields[1];
+    int day = firstWidth == 4 ? fields[2] : fields[0];
+    if (month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month) || fields[3] > 23 || fields[4] > 59 || fields[5] > 59) {
+        return false;
+    }
+    epoch = daysFromCivil(year, month, day) * 86400 + fields[3] * 3600 + fields[4] * 60 + fields[5];
+    return true;
+}
+
+// Days since 1970-01-01 of a proleptic Gregorian date (H. Hinnant, chrono-Compatible Low-Level Date Algorithms)
+long long Date::daysFromCivil(int year, int month, int day)
+{
+    year -= month <= 2;
+    const long long era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(year - era * 400);
+    const unsigned doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<long long>(doe) - 719468;
+}
+
+// Inverse of daysFromCivil
+void Date::civilFromDays(long long days, int& year, int& month, int& day)
+{
+    days += 719468;
+    const long long era = (days >= 0 ? days : days - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(days - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    day = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+    month = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+    year = static_cast<int>(yoe + era * 400 + (month <= 2));
+}
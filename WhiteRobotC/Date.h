@@ -16,8 +16,20 @@ class Date {
     std::string year = "";
     std::vector<std::string> seglist;
 public:
+    // Text layouts of the "time" column, stored in the binary price cache
+    enum Format { UNKNOWN = 0, DMY_HM = 1, ISO_HMS = 2 };
+
     Date(std::string userinput);
     std::string reformat_date();
+
+    // Epoch seconds (no time zone) <-> the fixed-width text layouts of the data files
+    static int detectFormat(const char* first, const char* last);
+    static bool parseEpoch(const char* first, const char* last, int format, long long& epoch);
+    static std::string formatEpoch(long long epoch, int format);
+    // Lenient parser for dates typed in the menu, "YYYY-MM-DD HH:MM" or "DD/MM/YYYY HH:MM", time optional
+    static bool parseUserDate(const std::string& text, long long& epoch);
+    static long long daysFromCivil(int year, int month, int day);
+    static void civilFromDays(long long days, int& year, int& month, int& day);
 };
 
 
@@ -0,0 +1,191 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	EventBacktester.cpp
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Runs White Robots from one crossing of their moving averages to the
+*					next, instead of bar by bar.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+* Other files	:	EventIndex.cpp holds the crossings, BatchBacktester.cpp the bar by bar version.
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*								#INCLUDES AND #CONSTANTS								*
+****************************************************************************************/
+
+#include "EventBacktester.h"
+
+#include <iostream>
+#include <algorithm>
+
+/****************************************************************************************
+*									MEMBER FUNCTIONS									*
+****************************************************************************************/
+
+//public member functions
+
+void EventBacktester::run(const vector<RobotParameters>& parameters, double intialCash) {
+	run(parameters, intialCash, 0, static_cast<int>(m_data->prices.size()) - 1);
+}
+
+void EventBacktester::run(const vector<RobotParameters>& parameters, double intialCash, int first, int last) {
+	m_statistics.clear();
+	for (const RobotParameters& p : parameters) {
+		m_statistics.push_back(simulate(p, intialCash, first, last));
+	}
+}
+
+
+//private member functions
+
+StrategyStatistics EventBacktester::simulate(const RobotParameters& p, double intialCash, int first, int last) {
+	StrategyStatistics statistics = {};
+	statistics.initial_portfolio_value = intialCash;
+	statistics.final_portfolio_value = intialCash;
+
+	if (p.maPointsS_long <= 1 || p.maPointsM_long <= 1 || p.maPointsL_long <= 1 || p.maPointsS_short <= 1 ||
+		p.maPointsM_short <= 1 || p.maPointsL_short <= 1 || p.slopePoints <= 1) {
+		cout << " Strategy Impossible to execute" << endl;
+		return statistics;
+	}
+
+	const vector<double>& prices = m_data->prices;
+	const IndicatorTable& indicators = m_data->indicators;
+	const EventIndex& events = m_data->events;
+	const int start = max({ first, p.maPointsS_long, p.maPointsM_long, p.maPointsL_long, p.maPointsS_short, p.maPointsM_short,
+		p.maPointsL_short, p.slopePoints });
+
+	// Crossings the modes react to and the Crossing bits they set. At the first point the
+	// previous averages are the zero padding, nothing crosses there.
+	struct Source {
+		shared_ptr<const vector<int>> crossings;
+		size_t next;
+		bool short_side;
+		int up;
+		int down;
+	};
+	Source sources[4];
+	int count = 0;
+	auto add = [&](int first, int second, bool short_side, int up, int down) {
+		shared_ptr<const vector<int>> crossings = events.crossings(first, second);
+		size_t next = lower_bound(crossings->begin(), crossings->end(), 2 * (start + 1)) - crossings->begin();
+		sources[count++] = { move(crossings), next, short_side, up, down };
+	};
+	const bool trades_long = p.mode_long >= 1 && p.mode_long <= 7;
+	const bool trades_short = p.mode_long != 0 && p.mode_short >= 1 && p.mode_short <= 7;
+	if (trades_long && p.mode_long != 4) {
+		add(p.maPointsS_long, p.maPointsM_long, false, WhiteStrategy::UP_MEDIUM, WhiteStrategy::DOWN_MEDIUM);
+	}
+	if (trades_long && p.mode_long != 7) {
+		add(p.maPointsS_long, p.maPointsL_long, false, WhiteStrategy::UP_LARGE, WhiteStrategy::DOWN_LARGE);
+	}
+	if (trades_short && p.mode_short != 4) {
+		add(p.maPointsS_short, p.maPointsM_short, true, WhiteStrategy::UP_MEDIUM, WhiteStrategy::DOWN_MEDIUM);
+	}
+	if (trades_short && p.mode_short != 7) {
+		add(p.maPointsS_short, p.maPointsL_short, true, WhiteStrategy::UP_LARGE, WhiteStrategy::DOWN_LARGE);
+	}
+
+	int state = 1;
+	int order = 0;
+	double current_cash = intialCash;
+	double cfd_units = 0;
+	double last_trade_investment = 1;
+
+	// Same expressions as WhiteStrategy::executeOrder and stopLossReached
+	auto value = [&](double price) {
+		return order == 1 ? current_cash + cfd_units * price
+			: (order == -1 ? current_cash + 2 * last_trade_investment - cfd_units * price : current_cash);
+	};
+	auto stops = [&](double price) {
+		double current_trade_profit = (value(price) - last_trade_investment) / last_trade_investment;
+		return current_trade_profit < -p.stopLoss;
+	};
+
+	// Checks of the pruning rule are at the multiples of checkpointPoints in (start, last)
+	const int checkpoints = m_pruning.checkpointPoints;
+	int checkpoint = m_pruning.enabled() ? (start / checkpoints + 1) * checkpoints : last;
+	double peak = intialCash;
+	auto pruned = [&](int at) {
+		statistics.final_portfolio_value = value(prices[at]);
+		statistics.pruned_point = at;
+		return statistics;
+	};
+
+	// The first point changes nothing, without crossings the state stays 1
+	int point = start;
+	while (point < last) {
+		int next = last;
+		for (int i = 0; i < count; ++i) {
+			if (sources[i].next < sources[i].crossings->size()) {
+				next = min(next, EventIndex::point((*sources[i].crossings)[sources[i].next]));
+			}
+		}
+		if (order != 0) {
+			// A stop loss at a point tests the portfolio value of the point before
+			int falls = order == 1 ? events.firstLow(point, next - 1, stops) : events.firstHigh(point, next - 1, stops);
+			next = min(next, falls + 1);
+		}
+
+		// Nothing changes before next, the positions are valued at the checks on the way
+		for (; checkpoint < next; checkpoint += checkpoints) {
+			if (m_pruning.prunes(value(prices[checkpoint]), peak)) {
+				return pruned(checkpoint);
+			}
+		}
+
+		int long_crossings = 0, short_crossings = 0;
+		for (int i = 0; i < count; ++i) {
+			Source& source = sources[i];
+			if (source.next < source.crossings->size() && EventIndex::point((*source.crossings)[source.next]) == next) {
+				int bit = EventIndex::up((*source.crossings)[source.next]) ? source.up : source.down;
+				(source.short_side ? short_crossings : long_crossings) |= bit;
+				++source.next;
+			}
+		}
+
+		if (ws.stopLossReached(last_trade_investment, value(prices[next - 1]), state, statistics.long_stop_loss, p.stopLoss,
+			statistics.short_stop_loss, next == last)) {
+			// Slop loss limit reached in the previous point
+			state = 1;
+		}
+		else {
+			// The trend is only read in state 1
+			double slope = 0;
+			if (state == 1) {
+				slope = indicators.slope(next, p.slopePoints);
+				indicators.settleThreshold(next, p.slopePoints, slope, p.slopeMin_long);
+				indicators.settleThreshold(next, p.slopePoints, slope, -p.slopeMin_short);
+			}
+			state = ws.nextState(state, slope, long_crossings, short_crossings, p.slopeMin_long, p.mode_long, p.slopeMin_short,
+				p.mode_short);
+		}
+
+		int new_order = ws.stateAnalyser(state);
+		if (new_order != order) {
+			double trade_profit;
+			ws.executeOrder(new_order, order, prices[next], current_cash, last_trade_investment, cfd_units, statistics.long_trades,
+				statistics.short_trades, statistics.long_trades_profit, statistics.good_long_trades, statistics.short_trades_profit,
+				statistics.good_short_trades, trade_profit);
+			order = new_order;
+		}
+		point = next;
+
+		if (checkpoint == next && next < last) {
+			if (m_pruning.prunes(value(prices[next]), peak)) {
+				return pruned(next);
+			}
+			checkpoint += checkpoints;
+		}
+	}
+
+	if (start <= last) {
+		statistics.final_portfolio_value = value(prices[last]);
+	}
+	return statistics;
+}
@@ -0,0 +1,79 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	EventBacktester.h
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Runs White Robots from one crossing of their moving averages to the
+*					next, instead of bar by bar.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+* Other files	:	EventIndex.h holds the crossings, BatchBacktester.h the bar by bar version.
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*							#GUARDS #INCLUDES AND #CONSTANTS							*
+****************************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include "WhiteRobot.h"
+#include "WhiteStrategy.h"
+using namespace std;
+
+/****************************************************************************************
+*									CLASS DECLARATION									*
+****************************************************************************************/
+
+// Same results as WhiteRobot::RunStrategySummary. The state machine only moves on a
+// crossing of the averages its modes compare, and an open trade only changes when its stop
+// loss triggers, so a robot visits the crossings of its windows (shared through the
+// EventIndex of the dataset), the points where a stop loss triggers and the last point.
+// In between the portfolio is not valued.
+class EventBacktester
+{
+
+public:
+
+	//constructors
+
+	explicit EventBacktester(shared_ptr<const MarketData> data) : m_data(data) {}
+
+
+	//Getters
+
+	size_t size() const { return m_statistics.size(); }
+
+	// Stops the robots rule prunes, off by default
+	void setPruning(const PruningRule& rule) { m_pruning = rule; }
+
+	StrategyStatistics getStatistics(size_t robot) const { return m_statistics[robot]; }
+
+
+	//public member functions
+
+	// Simulates every parameter set from intialCash, results through getStatistics
+	void run(const vector<RobotParameters>& parameters, double intialCash);
+
+	// Same, trading in the points first to last only as if the data ended at last. The
+	// points before first are history for the averages and slopes
+	void run(const vector<RobotParameters>& parameters, double intialCash, int first, int last);
+
+private:
+
+	//private member functions
+
+	StrategyStatistics simulate(const RobotParameters& p, double intialCash, int first, int last);
+
+	//private variable members
+
+	shared_ptr<const MarketData> m_data; // Dataset shared with the robots of the sweep
+	vector<StrategyStatistics> m_statistics; // Results of the last run
+	PruningRule m_pruning; // Early stop of the robots
+	WhiteStrategy ws; // Brain of the robots
+};
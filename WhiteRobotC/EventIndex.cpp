@@ -0,0 +1,110 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	EventIndex.cpp
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Points of a price series where one moving average crosses another,
+*					and price extremes of blocks of points to find stop losses quickly.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+* Other files	:	IndicatorTable.cpp provides the averages.
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*								#INCLUDES AND #CONSTANTS								*
+****************************************************************************************/
+
+#include "EventIndex.h"
+
+#include <algorithm>
+
+/****************************************************************************************
+*									MEMBER FUNCTIONS									*
+****************************************************************************************/
+
+//public member functions
+
+void EventIndex::build(const std::vector<double>& prices, const IndicatorTable& indicators, size_t maxStored) {
+	m_prices = prices.data();
+	m_indicators = &indicators;
+	m_size = static_cast<int>(prices.size());
+	m_maxStored = maxStored;
+
+	int blocks = (m_size + kBlockSize - 1) / kBlockSize;
+	m_blockMin.assign(blocks, 0);
+	m_blockMax.assign(blocks, 0);
+	for (int block = 0; block < blocks; ++block) {
+		auto first = prices.begin() + block * kBlockSize;
+		auto last = prices.begin() + std::min((block + 1) * kBlockSize, m_size);
+		m_blockMin[block] = *std::min_element(first, last);
+		m_blockMax[block] = *std::max_element(first, last);
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_recent.clear();
+	m_crossings.clear();
+	m_stored = 0;
+}
+
+size_t EventIndex::storedPairs() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_recent.size();
+}
+
+std::shared_ptr<const std::vector<int>> EventIndex::crossings(int firstWindow, int secondWindow) const {
+	const Pair key(firstWindow, secondWindow);
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto it = m_crossings.find(key);
+		if (it != m_crossings.end()) {
+			m_recent.splice(m_recent.begin(), m_recent, it->second);
+			return it->second->second;
+		}
+	}
+
+	// Computed outside the lock, a robot asking for another pair does not wait
+	std::vector<int> found;
+	const int first = std::max(firstWindow, secondWindow);
+	int previous = 0;
+	for (int from = first; from < m_size && firstWindow != secondWindow; from += kChunkSize) {
+		// In chunks, the buffers stay in cache and are not allocated for every pair
+		double firstValues[kChunkSize], secondValues[kChunkSize];
+		const int to = std::min(from + kChunkSize, m_size) - 1;
+		m_indicators->averages(from, to, firstWindow, firstValues);
+		m_indicators->averages(from, to, secondWindow, secondValues);
+
+		for (int at = from; at <= to; ++at) {
+			double firstValue = firstValues[at - from];
+			double secondValue = secondValues[at - from];
+			if (IndicatorTable::nearlyTied(firstValue, secondValue)) {
+				m_indicators->settleTie(at, firstWindow, firstValue, secondWindow, secondValue);
+			}
+			int side = (firstValue > secondValue) - (firstValue < secondValue);
+			if (side * previous == -1) {
+				found.push_back(2 * at + (side > 0 ? 1 : 0));
+			}
+			previous = side;
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto it = m_crossings.find(key);
+	if (it != m_crossings.end()) {
+		// Another robot computed the same pair meanwhile
+		m_recent.splice(m_recent.begin(), m_recent, it->second);
+		return it->second->second;
+	}
+	m_stored += found.size();
+	m_recent.emplace_front(key, std::make_shared<const std::vector<int>>(std::move(found)));
+	m_crossings.emplace(key, m_recent.begin());
+	while (m_stored > m_maxStored && m_recent.size() > 1) {
+		m_stored -= m_recent.back().second->size();
+		m_crossings.erase(m_recent.back().first);
+		m_recent.pop_back();
+	}
+	return m_recent.front().second;
+}
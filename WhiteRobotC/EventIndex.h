@@ -0,0 +1,144 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	EventIndex.h
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Points of a price series where one moving average crosses another,
+*					and price extremes of blocks of points to find stop losses quickly.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+* Other files	:	IndicatorTable.h provides the averages.
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*							#GUARDS #INCLUDES AND #CONSTANTS							*
+****************************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include "IndicatorTable.h"
+
+/****************************************************************************************
+*									CLASS DECLARATION									*
+****************************************************************************************/
+
+// The crossings of a pair of windows are computed for the whole series the first time a
+// robot asks for them and kept, every robot of a sweep using the same pair shares them.
+// The pairs used least recently are dropped once too many crossings are kept, a robot
+// still running on them holds its own reference. Safe to use from several threads once built.
+class EventIndex
+{
+
+public:
+
+	//constructors
+
+	EventIndex() : m_prices(nullptr), m_indicators(nullptr), m_size(0), m_maxStored(kMaxStored) {}
+
+	EventIndex(const EventIndex&) = delete;
+	EventIndex& operator=(const EventIndex&) = delete;
+
+
+	//Getters
+
+	// A crossing is stored as 2 * point + 1 when the first average crosses over the second
+	// one and 2 * point when it crosses under
+	static int point(int crossing) { return crossing >> 1; }
+	static bool up(int crossing) { return crossing & 1; }
+
+
+	//public member functions
+
+	// Points to the prices and their table, drops the crossings of any previous series. At
+	// most maxStored crossings are kept, besides the pair asked for last
+	void build(const std::vector<double>& prices, const IndicatorTable& indicators, size_t maxStored = kMaxStored);
+
+	// Pairs whose crossings are kept
+	size_t storedPairs() const;
+
+	// Points where the average of firstWindow goes from strictly below to strictly above the
+	// average of secondWindow, or the other way round, from one point to the next. The
+	// averages are compared as WhiteRobot::readSignals settles them, in increasing order.
+	std::shared_ptr<const std::vector<int>> crossings(int firstWindow, int secondWindow) const;
+
+	// First point in [first, last] whose price passes test, last + 1 if none. Once test
+	// passes for a price it must pass for every lower one (firstLow) or every higher one
+	// (firstHigh), blocks whose extreme price fails are skipped
+	template <typename Test>
+	int firstLow(int first, int last, Test test) const;
+	template <typename Test>
+	int firstHigh(int first, int last, Test test) const;
+
+private:
+
+	static const int kBlockSize = 64;
+
+	// Points whose averages crossings compares at a time
+	static const int kChunkSize = 1024;
+
+	// Crossings kept for all the pairs by default, 16 MB
+	static const size_t kMaxStored = size_t(1) << 22;
+
+	typedef std::pair<int, int> Pair;
+	typedef std::pair<Pair, std::shared_ptr<const std::vector<int>>> Entry;
+
+	const double* m_prices; // Series of the index, not owned
+	const IndicatorTable* m_indicators; // Prefix sums of the series, not owned
+	int m_size; // Number of prices
+	std::vector<double> m_blockMin; // Lowest price of every block of kBlockSize points
+	std::vector<double> m_blockMax; // Highest price of every block
+
+	size_t m_maxStored; // Crossings kept for all the pairs
+	mutable std::mutex m_mutex; // Guards the crossings
+	mutable std::list<Entry> m_recent; // Crossings by pair of windows, most recently used first
+	mutable std::map<Pair, std::list<Entry>::iterator> m_crossings; // Pair to its entry in m_recent
+	mutable size_t m_stored = 0; // Crossings in m_recent
+};
+
+/****************************************************************************************
+*									TEMPLATE MEMBERS									*
+****************************************************************************************/
+
+template <typename Test>
+int EventIndex::firstLow(int first, int last, Test test) const {
+	int at = first;
+	while (at <= last) {
+		if (at % kBlockSize == 0 && at + kBlockSize - 1 <= last && !test(m_blockMin[at / kBlockSize])) {
+			at += kBlockSize;
+		}
+		else if (test(m_prices[at])) {
+			return at;
+		}
+		else {
+			++at;
+		}
+	}
+	return last + 1;
+}
+
+template <typename Test>
+int EventIndex::firstHigh(int first, int last, Test test) const {
+	int at = first;
+	while (at <= last) {
+		if (at % kBlockSize == 0 && at + kBlockSize - 1 <= last && !test(m_blockMax[at / kBlockSize])) {
+			at += kBlockSize;
+		}
+		else if (test(m_prices[at])) {
+			return at;
+		}
+		else {
+			++at;
+		}
+	}
+	return last + 1;
+}
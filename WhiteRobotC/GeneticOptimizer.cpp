@@ -0,0 +1,247 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	GeneticOptimizer.cpp
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Evolutionary search of White Robot parameters: a population of robots
+*					bred by tournament selection, crossover and mutation.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+*					- D. E. Goldberg: Genetic Algorithms in Search, Optimization and
+*					  Machine Learning. Addison Wesley. 1989. ISBN 0-201-15767-5.
+* Other files	:	SweepRunner.cpp draws every robot independently instead.
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*								#INCLUDES AND #CONSTANTS								*
+****************************************************************************************/
+
+#include "GeneticOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+namespace {
+
+	// Sampled values of the real parameters have 4 decimals, as in the random sweeps
+	double roundParameter(double value) {
+		return floor((value * 10000) + .5) / 10000;
+	}
+
+	// value moved by a normal step of a tenth of the interval, at least one for integers,
+	// kept in [lowest, highest]
+	int mutateInteger(int value, int lowest, int highest, mt19937& rng) {
+		normal_distribution<double> step(0, max(1.0, (highest - lowest) / 10.0));
+		int moved = value + static_cast<int>(lround(step(rng)));
+		return min(max(moved, lowest), highest);
+	}
+
+	double mutateReal(double value, double lowest, double highest, mt19937& rng) {
+		normal_distribution<double> step(0, (highest - lowest) / 10.0);
+		return roundParameter(min(max(value + step(rng), lowest), highest));
+	}
+
+	// The modes are not ordered, a mutated mode is drawn again
+	int mutateMode(int lowest, int highest, mt19937& rng) {
+		return uniform_int_distribution<int>(lowest, highest)(rng);
+	}
+}
+
+/****************************************************************************************
+*									MEMBER FUNCTIONS									*
+****************************************************************************************/
+
+//constructors
+
+GeneticOptimizer::GeneticOptimizer(const WhiteRobot& source, ThreadPool& pool) :
+	m_source(source), m_scheduler(pool), m_batches(m_scheduler.workers()), m_population(64), m_best(), m_bestStatistics() {
+	for (int worker = 0; worker < m_scheduler.workers(); ++worker) {
+		m_backtesters.emplace_back(source.getData());
+	}
+}
+
+
+//public member functions
+
+int GeneticOptimizer::run(const ParameterRange& range, int maxSimulations, double targetReturn, double intialCash,
+	unsigned int seed, const string& fileName) {
+
+	mt19937 rng(seed);
+	m_cache.clear();
+	unique_ptr<SimulationWriter> writer;
+	if (!fileName.empty()) {
+		writer.reset(new SimulationWriter(fileName, m_source.getData()));
+	}
+	SimulationWriter::Clock clock;
+	string rows;
+
+	auto percent = [](const StrategyStatistics& statistics) {
+		return 100 * (statistics.final_portfolio_value - statistics.initial_portfolio_value) / statistics.initial_portfolio_value;
+	};
+	auto better = [](const Robot& a, const Robot& b) {
+		return a.statistics.final_portfolio_value > b.statistics.final_portfolio_value;
+	};
+
+	vector<Robot> population;
+	vector<Robot> children;
+	int simulations = 0;
+	int generation = 0;
+	bool reached = false;
+	double bestReturn = 0; // Printed when it improves
+	while (simulations < maxSimulations && !reached) {
+		// The first generation is drawn at random, the next ones are bred from the last one
+		children.clear();
+		int size = min(generation == 0 ? m_population : m_population - kElite, maxSimulations - simulations);
+		for (int i = 0; i < size; ++i) {
+			Robot child = {};
+			if (generation == 0) {
+				child.parameters = draw(range, rng);
+			}
+			else {
+				const Robot& a = tournament(population, rng);
+				const Robot& b = tournament(population, rng);
+				child.parameters = breed(a.parameters, b.parameters, range, rng);
+			}
+			children.push_back(child);
+		}
+		evaluate(children, intialCash);
+		simulations += static_cast<int>(children.size());
+
+		rows.clear();
+		for (const Robot& child : children) {
+			if (writer) {
+				writer->formatRow(child.parameters, child.statistics, clock.now(), rows);
+			}
+			reached = reached || percent(child.statistics) >= targetReturn;
+		}
+		if (writer) {
+			writer->write(rows);
+		}
+
+		// Elite of the last generation and the children, best first
+		if (generation > 0) {
+			population.resize(min<size_t>(kElite, population.size()));
+		}
+		population.insert(population.end(), children.begin(), children.end());
+		stable_sort(population.begin(), population.end(), better);
+
+		if (generation == 0 || percent(population.front().statistics) > bestReturn) {
+			bestReturn = percent(population.front().statistics);
+			cout << "Generation " << generation << ": " << simulations << " simulations, best return " << fixed << setprecision(2)
+				<< bestReturn << "%" << defaultfloat << endl;
+		}
+		++generation;
+	}
+
+	if (!population.empty()) {
+		m_best = population.front().parameters;
+		m_bestStatistics = population.front().statistics;
+	}
+	m_cache.printHitRate(cout);
+	return simulations;
+}
+
+
+//private member functions
+
+RobotParameters GeneticOptimizer::draw(const ParameterRange& range, mt19937& rng) {
+	const RobotParameters& lo = range.lowest;
+	const RobotParameters& hi = range.highest;
+	RobotParameters p;
+	p.maPointsS_long = uniform_int_distribution<int>(lo.maPointsS_long, hi.maPointsS_long)(rng);
+	p.maPointsM_long = uniform_int_distribution<int>(lo.maPointsM_long, hi.maPointsM_long)(rng);
+	p.maPointsL_long = uniform_int_distribution<int>(lo.maPointsL_long, hi.maPointsL_long)(rng);
+	p.slopeMin_long = roundParameter(uniform_real_distribution<double>(lo.slopeMin_long, hi.slopeMin_long)(rng));
+	p.mode_long = uniform_int_distribution<int>(lo.mode_long, hi.mode_long)(rng);
+
+	p.maPointsS_short = uniform_int_distribution<int>(lo.maPointsS_short, hi.maPointsS_short)(rng);
+	p.maPointsM_short = uniform_int_distribution<int>(lo.maPointsM_short, hi.maPointsM_short)(rng);
+	p.maPointsL_short = uniform_int_distribution<int>(lo.maPointsL_short, hi.maPointsL_short)(rng);
+	p.slopeMin_short = roundParameter(uniform_real_distribution<double>(lo.slopeMin_short, hi.slopeMin_short)(rng));
+	p.mode_short = uniform_int_distribution<int>(lo.mode_short, hi.mode_short)(rng);
+
+	p.slopePoints = uniform_int_distribution<int>(lo.slopePoints, hi.slopePoints)(rng);
+	p.stopLoss = roundParameter(uniform_real_distribution<double>(lo.stopLoss, hi.stopLoss)(rng));
+	return p;
+}
+
+RobotParameters GeneticOptimizer::breed(const RobotParameters& a, const RobotParameters& b, const ParameterRange& range,
+	mt19937& rng) {
+	const RobotParameters& lo = range.lowest;
+	const RobotParameters& hi = range.highest;
+	bernoulli_distribution fromA(0.5);
+	bernoulli_distribution mutates(1.0 / 12);
+
+	RobotParameters p;
+	p.maPointsS_long = fromA(rng) ? a.maPointsS_long : b.maPointsS_long;
+	p.maPointsM_long = fromA(rng) ? a.maPointsM_long : b.maPointsM_long;
+	p.maPointsL_long = fromA(rng) ? a.maPointsL_long : b.maPointsL_long;
+	p.slopeMin_long = fromA(rng) ? a.slopeMin_long : b.slopeMin_long;
+	p.mode_long = fromA(rng) ? a.mode_long : b.mode_long;
+
+	p.maPointsS_short = fromA(rng) ? a.maPointsS_short : b.maPointsS_short;
+	p.maPointsM_short = fromA(rng) ? a.maPointsM_short : b.maPointsM_short;
+	p.maPointsL_short = fromA(rng) ? a.maPointsL_short : b.maPointsL_short;
+	p.slopeMin_short = fromA(rng) ? a.slopeMin_short : b.slopeMin_short;
+	p.mode_short = fromA(rng) ? a.mode_short : b.mode_short;
+
+	p.slopePoints = fromA(rng) ? a.slopePoints : b.slopePoints;
+	p.stopLoss = fromA(rng) ? a.stopLoss : b.stopLoss;
+
+	if (mutates(rng)) p.maPointsS_long = mutateInteger(p.maPointsS_long, lo.maPointsS_long, hi.maPointsS_long, rng);
+	if (mutates(rng)) p.maPointsM_long = mutateInteger(p.maPointsM_long, lo.maPointsM_long, hi.maPointsM_long, rng);
+	if (mutates(rng)) p.maPointsL_long = mutateInteger(p.maPointsL_long, lo.maPointsL_long, hi.maPointsL_long, rng);
+	if (mutates(rng)) p.slopeMin_long = mutateReal(p.slopeMin_long, lo.slopeMin_long, hi.slopeMin_long, rng);
+	if (mutates(rng)) p.mode_long = mutateMode(lo.mode_long, hi.mode_long, rng);
+
+	if (mutates(rng)) p.maPointsS_short = mutateInteger(p.maPointsS_short, lo.maPointsS_short, hi.maPointsS_short, rng);
+	if (mutates(rng)) p.maPointsM_short = mutateInteger(p.maPointsM_short, lo.maPointsM_short, hi.maPointsM_short, rng);
+	if (mutates(rng)) p.maPointsL_short = mutateInteger(p.maPointsL_short, lo.maPointsL_short, hi.maPointsL_short, rng);
+	if (mutates(rng)) p.slopeMin_short = mutateReal(p.slopeMin_short, lo.slopeMin_short, hi.slopeMin_short, rng);
+	if (mutates(rng)) p.mode_short = mutateMode(lo.mode_short, hi.mode_short, rng);
+
+	if (mutates(rng)) p.slopePoints = mutateInteger(p.slopePoints, lo.slopePoints, hi.slopePoints, rng);
+	if (mutates(rng)) p.stopLoss = mutateReal(p.stopLoss, lo.stopLoss, hi.stopLoss, rng);
+	return p;
+}
+
+const GeneticOptimizer::Robot& GeneticOptimizer::tournament(const vector<Robot>& population, mt19937& rng) const {
+	uniform_int_distribution<size_t> pick(0, population.size() - 1);
+	const Robot* best = &population[pick(rng)];
+	for (int i = 1; i < kTournament; ++i) {
+		const Robot& other = population[pick(rng)];
+		if (other.statistics.final_portfolio_value > best->statistics.final_portfolio_value) {
+			best = &other;
+		}
+	}
+	return *best;
+}
+
+void GeneticOptimizer::evaluate(vector<Robot>& robots, double intialCash) {
+	const int count = static_cast<int>(robots.size());
+	m_scheduler.run((count + kBatchSize - 1) / kBatchSize, [&](int worker, int job) {
+		int first = job * kBatchSize;
+		int last = min(first + kBatchSize, count);
+
+		// Only the robots without cached results go through the backtester
+		vector<RobotParameters>& batch = m_batches[worker];
+		batch.clear();
+		vector<int> positions;
+		for (int i = first; i < last; i++) {
+			if (!m_cache.find(robots[i].parameters, robots[i].statistics)) {
+				batch.push_back(robots[i].parameters);
+				positions.push_back(i);
+			}
+		}
+		m_backtesters[worker].run(batch, intialCash);
+		for (size_t k = 0; k < batch.size(); k++) {
+			robots[positions[k]].statistics = m_backtesters[worker].getStatistics(k);
+			m_cache.insert(batch[k], robots[positions[k]].statistics);
+		}
+	});
+}
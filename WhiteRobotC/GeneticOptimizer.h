@@ -0,0 +1,117 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	GeneticOptimizer.h
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Evolutionary search of White Robot parameters: a population of robots
+*					bred by tournament selection, crossover and mutation.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+*					- D. E. Goldberg: Genetic Algorithms in Search, Optimization and
+*					  Machine Learning. Addison Wesley. 1989. ISBN 0-201-15767-5.
+* Other files	:	SweepRunner.h draws every robot independently instead.
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*							#GUARDS #INCLUDES AND #CONSTANTS							*
+****************************************************************************************/
+
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <random>
+#include "WhiteRobot.h"
+#include "ParameterRange.h"
+#include "EventBacktester.h"
+#include "SimulationCache.h"
+#include "SimulationWriter.h"
+#include "ThreadPool.h"
+#include "WorkStealingScheduler.h"
+using namespace std;
+
+/****************************************************************************************
+*									CLASS DECLARATION									*
+****************************************************************************************/
+
+// Every generation keeps its best robots and fills the rest of the population with children
+// of parents chosen by tournament: every parameter comes from one of the two parents, then
+// mutates with probability 1/12. The children of a generation are simulated in parallel,
+// one EventBacktester per worker, and a child simulating as an earlier robot takes its
+// results from a SimulationCache. The same seed gives the same search on any number of
+// threads.
+class GeneticOptimizer
+{
+
+public:
+
+	//constructors
+
+	GeneticOptimizer(const WhiteRobot& source, ThreadPool& pool);
+
+
+	//Getters and setters
+
+	// Robots per generation, at least 4
+	void setPopulation(int population) { m_population = max(population, 4); }
+
+	RobotParameters getBest() const { return m_best; }
+
+	StrategyStatistics getBestStatistics() const { return m_bestStatistics; }
+
+
+	//public member functions
+
+	// Breeds robots in range until one returns targetReturn percent or maxSimulations
+	// robots have been simulated, and returns the number simulated. Every robot is appended
+	// to fileName as a summary row, none if fileName is empty.
+	int run(const ParameterRange& range, int maxSimulations, double targetReturn, double intialCash, unsigned int seed,
+		const string& fileName);
+
+	// Parameters drawn uniformly in range, as closedRandomWhite does
+	static RobotParameters draw(const ParameterRange& range, mt19937& rng);
+
+private:
+
+	// Robots simulated together by one job
+	static const int kBatchSize = 64;
+
+	// Robots of the population kept unchanged in the next generation
+	static const int kElite = 2;
+
+	// Robots taking part in a tournament
+	static const int kTournament = 3;
+
+	struct Robot {
+		RobotParameters parameters;
+		StrategyStatistics statistics;
+	};
+
+	//private member functions
+
+	// Child of a and b: crossover of every parameter, then mutation
+	static RobotParameters breed(const RobotParameters& a, const RobotParameters& b, const ParameterRange& range, mt19937& rng);
+
+	// Best of kTournament robots of the population drawn at random
+	const Robot& tournament(const vector<Robot>& population, mt19937& rng) const;
+
+	// Fills the statistics of robots, in parallel
+	void evaluate(vector<Robot>& robots, double intialCash);
+
+	//private variable members
+
+	const WhiteRobot& m_source; // Robot holding the loaded data
+	WorkStealingScheduler m_scheduler; // Hands the simulations of a generation to the workers
+	vector<EventBacktester> m_backtesters; // One per worker
+	vector<vector<RobotParameters>> m_batches; // Robots of the job of every worker
+	SimulationCache m_cache; // Results of the current search
+	int m_population; // Robots per generation
+	RobotParameters m_best; // Best robot of the last search
+	StrategyStatistics m_bestStatistics; // Its results
+};
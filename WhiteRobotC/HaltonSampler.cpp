@@ -0,0 +1,110 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	HaltonSampler.cpp
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Scrambled Halton sequence over the 12 parameters of a White Robot, a
+*					quasi-random alternative to drawing them uniformly.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+*					- J. Matousek: On the L2-discrepancy for anchored boxes. Journal of
+*					  Complexity 14, 527-556. 1998.
+* Other files	:	GeneticOptimizer.cpp draws the parameters uniformly (draw).
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*								#INCLUDES AND #CONSTANTS								*
+****************************************************************************************/
+
+#include "HaltonSampler.h"
+
+#include <cmath>
+#include <random>
+#include <numeric>
+#include <algorithm>
+
+namespace {
+
+	// Base of every dimension, the first primes
+	const int kBases[HaltonSampler::kDimensions] = { 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37 };
+
+	// Integer of [lowest, highest] for a coordinate in [0, 1)
+	int integer(double coordinate, int lowest, int highest) {
+		int offset = static_cast<int>(coordinate * (static_cast<double>(highest) - lowest + 1));
+		return lowest + min(offset, highest - lowest);
+	}
+
+	// Value of [lowest, highest] for a coordinate, rounded to 4 decimals
+	double real(double coordinate, double lowest, double highest) {
+		return floor(((lowest + coordinate * (highest - lowest)) * 10000) + .5) / 10000;
+	}
+}
+
+/****************************************************************************************
+*									MEMBER FUNCTIONS									*
+****************************************************************************************/
+
+//constructors
+
+HaltonSampler::HaltonSampler(unsigned int seed) {
+	for (int d = 0; d < kDimensions; ++d) {
+		const int base = kBases[d];
+		m_digits[d] = static_cast<int>(ceil(kBits * log(2.0) / log(static_cast<double>(base))));
+
+		seed_seq sequence{ seed, static_cast<unsigned int>(d) };
+		mt19937 rng(sequence);
+		m_permutations[d].resize(static_cast<size_t>(m_digits[d]) * base);
+		for (int k = 0; k < m_digits[d]; ++k) {
+			auto first = m_permutations[d].begin() + k * base;
+			iota(first, first + base, 0);
+			shuffle(first, first + base, rng);
+		}
+	}
+}
+
+
+//public member functions
+
+void HaltonSampler::point(unsigned long long index, double coordinates[kDimensions]) const {
+	for (int d = 0; d < kDimensions; ++d) {
+		const int base = kBases[d];
+		const int* permutation = m_permutations[d].data();
+		unsigned long long rest = index;
+		double scale = 1.0 / base;
+		double value = 0;
+		for (int k = 0; k < m_digits[d]; ++k) {
+			value += permutation[k * base + static_cast<int>(rest % base)] * scale;
+			rest /= base;
+			scale /= base;
+		}
+		coordinates[d] = value;
+	}
+}
+
+RobotParameters HaltonSampler::draw(const ParameterRange& range, unsigned long long index) const {
+	double u[kDimensions];
+	point(index, u);
+
+	const RobotParameters& lo = range.lowest;
+	const RobotParameters& hi = range.highest;
+	RobotParameters p;
+	p.maPointsS_long = integer(u[0], lo.maPointsS_long, hi.maPointsS_long);
+	p.maPointsM_long = integer(u[1], lo.maPointsM_long, hi.maPointsM_long);
+	p.maPointsL_long = integer(u[2], lo.maPointsL_long, hi.maPointsL_long);
+	p.slopeMin_long = real(u[3], lo.slopeMin_long, hi.slopeMin_long);
+	p.mode_long = integer(u[4], lo.mode_long, hi.mode_long);
+
+	p.maPointsS_short = integer(u[5], lo.maPointsS_short, hi.maPointsS_short);
+	p.maPointsM_short = integer(u[6], lo.maPointsM_short, hi.maPointsM_short);
+	p.maPointsL_short = integer(u[7], lo.maPointsL_short, hi.maPointsL_short);
+	p.slopeMin_short = real(u[8], lo.slopeMin_short, hi.slopeMin_short);
+	p.mode_short = integer(u[9], lo.mode_short, hi.mode_short);
+
+	p.slopePoints = integer(u[10], lo.slopePoints, hi.slopePoints);
+	p.stopLoss = real(u[11], lo.stopLoss, hi.stopLoss);
+	return p;
+}
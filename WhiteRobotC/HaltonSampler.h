@@ -0,0 +1,70 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	HaltonSampler.h
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Scrambled Halton sequence over the 12 parameters of a White Robot, a
+*					quasi-random alternative to drawing them uniformly.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+*					- J. Matousek: On the L2-discrepancy for anchored boxes. Journal of
+*					  Complexity 14, 527-556. 1998.
+* Other files	:	GeneticOptimizer.h draws the parameters uniformly (draw).
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*							#GUARDS #INCLUDES AND #CONSTANTS							*
+****************************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include "WhiteRobot.h"
+#include "ParameterRange.h"
+using namespace std;
+
+/****************************************************************************************
+*									CLASS DECLARATION									*
+****************************************************************************************/
+
+// Coordinate d of point i is the radical inverse of i in the d-th prime base, every digit
+// going through a random permutation of its own (seeded), zeros past the last digit of i
+// too. The points fill the space more evenly than independent uniform draws, and point i
+// only depends on the seed and i: parts of a sweep run with the same seed on disjoint
+// ranges of indices never draw the same point.
+class HaltonSampler
+{
+
+public:
+
+	// One per parameter, in the order of RobotParameters
+	static const int kDimensions = 12;
+
+	//constructors
+
+	explicit HaltonSampler(unsigned int seed);
+
+
+	//public member functions
+
+	// Point index of the sequence in [0, 1)^kDimensions, index below 2^40
+	void point(unsigned long long index, double coordinates[kDimensions]) const;
+
+	// Point index mapped onto range: windows, modes and slope points on equal shares of
+	// their integer intervals, slopes and stop losses rounded as closedRandomWhite does
+	RobotParameters draw(const ParameterRange& range, unsigned long long index) const;
+
+private:
+
+	// Bits of precision of every coordinate
+	static const int kBits = 40;
+
+	//private variable members
+
+	int m_digits[kDimensions]; // Digits of every coordinate, kBits bits worth
+	vector<int> m_permutations[kDimensions]; // Permutation of every digit, m_digits blocks of one per base value
+};
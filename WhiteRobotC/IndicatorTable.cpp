@@ -0,0 +1,151 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	IndicatorTable.cpp
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Prefix sums of a price series, any moving average or regression slope
+*					of the series becomes a constant time lookup.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+*					- T. J. Dekker: A floating-point technique for extending the available
+*					  precision. Numerische Mathematik 18. 1971.
+* Other files	:	Signal_Generator.cpp holds the reference (full window) versions.
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*								#INCLUDES AND #CONSTANTS								*
+****************************************************************************************/
+
+#include "IndicatorTable.h"
+
+#include <cmath>
+#include <algorithm>
+#include "Signal_Generator.h"
+
+/****************************************************************************************
+*									HELPER FUNCTIONS									*
+****************************************************************************************/
+
+namespace {
+
+	// hi + lo == a + b exactly, for any a and b
+	inline PrefixSum twoSum(double a, double b) {
+		double s = a + b;
+		double bb = s - a;
+		return { s, (a - (s - bb)) + (b - bb) };
+	}
+
+	inline PrefixSum add(PrefixSum a, double b) {
+		PrefixSum s = twoSum(a.hi, b);
+		double hi = s.hi + (s.lo + a.lo);
+		return { hi, (s.lo + a.lo) - (hi - s.hi) };
+	}
+
+	// Veltkamp split, hi + lo == a with 26 significant bits each. An integer below 2^27
+	// times either half is exact.
+	inline PrefixSum split(double a) {
+		double t = 134217729.0 * a;
+		double hi = t - (t - a);
+		return { hi, a - hi };
+	}
+
+	// a - b, rounded once relative to the (small) result rather than to the prefixes
+	inline PrefixSum difference(const PrefixSum& a, const PrefixSum& b) {
+		return { a.hi - b.hi, a.lo - b.lo };
+	}
+
+}
+
+/****************************************************************************************
+*									MEMBER FUNCTIONS									*
+****************************************************************************************/
+
+//public member functions
+
+void IndicatorTable::build(const std::vector<double>& prices) {
+	m_prices = prices.data();
+	m_size = prices.size();
+	m_sum.resize(m_size + 1);
+	m_sum[0] = { 0.0, 0.0 };
+
+	if (m_size > kMaxSlopeBars) {
+		m_weighted.clear();
+		m_weighted.shrink_to_fit();
+		for (std::size_t k = 0; k < m_size; ++k) {
+			m_sum[k + 1] = add(m_sum[k], m_prices[k]);
+		}
+		return;
+	}
+
+	m_weighted.resize(m_size + 1);
+	m_weighted[0] = { 0.0, 0.0 };
+	for (std::size_t k = 0; k < m_size; ++k) {
+		const double index = static_cast<double>(k);
+		PrefixSum price = split(m_prices[k]);
+		m_sum[k + 1] = add(m_sum[k], m_prices[k]);
+		m_weighted[k + 1] = add(add(m_weighted[k], index * price.hi), index * price.lo);
+	}
+}
+
+double IndicatorTable::average(int point, int windowSize) const {
+	PrefixSum sum = difference(m_sum[point + 1], m_sum[point + 1 - windowSize]);
+	return (sum.hi + sum.lo) / windowSize;
+}
+
+void IndicatorTable::averages(int first, int last, int windowSize, double* out) const {
+	for (int point = first; point <= last; ++point) {
+		PrefixSum sum = difference(m_sum[point + 1], m_sum[point + 1 - windowSize]);
+		out[point - first] = (sum.hi + sum.lo) / windowSize;
+	}
+}
+
+// With x centred on the window, Sum(x) = 0 and the slope is Sum((x - c) y) / Sum((x - c)^2).
+// Sum((x - c) y) = Sum(j y) - (start + c) Sum(y) cancels the two large prefix terms, which
+// is done on exact products: 2 (start + c) is an integer below 2^27.
+double IndicatorTable::slope(int point, int windowSize) const {
+	if (m_size > kMaxSlopeBars) {
+		return exactSlope(point, windowSize);
+	}
+	const int start = point + 1 - windowSize;
+	const double n = windowSize;
+
+	PrefixSum s_y = difference(m_sum[point + 1], m_sum[start]);
+	PrefixSum s_jy = difference(m_weighted[point + 1], m_weighted[start]);
+	PrefixSum y = split(s_y.hi);
+	const double halfCentre = 0.5 * (2.0 * start + n - 1);
+
+	double centred = s_jy.hi - halfCentre * y.hi;
+	centred -= halfCentre * y.lo;
+	centred += s_jy.lo - halfCentre * s_y.lo;
+	return 12.0 * centred / (n * (n * n - 1));
+}
+
+double IndicatorTable::exactAverage(int point, int windowSize) const {
+	double sum = 0.0;
+	for (int i = point - windowSize + 1; i <= point; ++i) {
+		sum += m_prices[i];
+	}
+	return sum / windowSize;
+}
+
+double IndicatorTable::exactSlope(int point, int windowSize) const {
+	Signal_Generator generate;
+	return generate.movingSlope(m_prices + point - windowSize + 1, windowSize);
+}
+
+void IndicatorTable::settleTie(int point, int firstWindow, double& firstValue, int secondWindow, double& secondValue) const {
+	if (nearlyTied(firstValue, secondValue)) {
+		firstValue = exactAverage(point, firstWindow);
+		secondValue = exactAverage(point, secondWindow);
+	}
+}
+
+void IndicatorTable::settleThreshold(int point, int windowSize, double& slope, double threshold) const {
+	if (std::fabs(slope - threshold) <= kTieTolerance * std::fabs(average(point, windowSize))) {
+		slope = exactSlope(point, windowSize);
+	}
+}
@@ -0,0 +1,97 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	IndicatorTable.h
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Prefix sums of a price series, any moving average or regression slope
+*					of the series becomes a constant time lookup.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+*					- T. J. Dekker: A floating-point technique for extending the available
+*					  precision. Numerische Mathematik 18. 1971.
+* Other files	:	Signal_Generator.h holds the reference (full window) versions.
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*							#GUARDS #INCLUDES AND #CONSTANTS							*
+****************************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+
+/****************************************************************************************
+*									CLASS DECLARATION									*
+****************************************************************************************/
+
+// Double-double value, hi + lo with |lo| <= ulp(hi) / 2
+struct PrefixSum {
+	double hi;
+	double lo;
+};
+
+// Sum(p[j]) and Sum(j * p[j]) for every prefix of the series, built once per dataset and
+// shared by every robot of a sweep. The sums grow with the square of the series length, so
+// they are kept as unevaluated pairs hi + lo (about 106 bits, Dekker) and the difference of
+// two prefixes keeps full double precision, also where long double is just a double.
+// Lookups are within a few ulps of Signal_Generator; where the state machine compares
+// nearly equal values the settle functions fall back to the exact window computations.
+class IndicatorTable
+{
+
+public:
+
+	//constructors
+
+	IndicatorTable() : m_prices(nullptr), m_size(0) {}
+
+
+	//public member functions
+
+	// One pass over the prices, the table points to them and must be rebuilt if they change.
+	// The slope sums are exact up to kMaxSlopeBars, longer series compute slopes directly.
+	void build(const std::vector<double>& prices);
+
+	std::size_t size() const { return m_size; }
+
+	// Average of the windowSize prices ending at point (inclusive)
+	double average(int point, int windowSize) const;
+
+	// average at every point of [first, last] into out[0 .. last - first]
+	void averages(int first, int last, int windowSize, double* out) const;
+
+	// Least squares slope of the windowSize prices ending at point, x = 0 for the oldest
+	double slope(int point, int windowSize) const;
+
+	// Signal_Generator::movingAverage and movingSlope over the window, O(windowSize)
+	double exactAverage(int point, int windowSize) const;
+	double exactSlope(int point, int windowSize) const;
+
+	// Whether settleTie replaces a and b
+	static bool nearlyTied(double a, double b) {
+		return std::fabs(a - b) <= kTieTolerance * std::max(std::fabs(a), std::fabs(b));
+	}
+
+	// Replaces two averages closer than kTieTolerance (relative) by their exact values
+	void settleTie(int point, int firstWindow, double& firstValue, int secondWindow, double& secondValue) const;
+
+	// Replaces a slope closer to threshold than kTieTolerance times the mean price by its exact value
+	void settleThreshold(int point, int windowSize, double& slope, double threshold) const;
+
+private:
+
+	static constexpr double kTieTolerance = 1e-9;
+	static constexpr std::size_t kMaxSlopeBars = std::size_t(1) << 26; // Bar indices times 26 bit halves stay exact
+
+	const double* m_prices; // Series the table was built from, not owned
+	std::size_t m_size; // Number of prices
+	std::vector<PrefixSum> m_sum; // m_sum[k] = p[0] + ... + p[k-1]
+	std::vector<PrefixSum> m_weighted; // m_weighted[k] = 0 * p[0] + ... + (k-1) * p[k-1], empty above kMaxSlopeBars
+};
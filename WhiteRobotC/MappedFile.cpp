@@ -0,0 +1,142 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	MappedFile.cpp
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Read-only memory mapping of a whole file.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+* Other files	:
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*								#INCLUDES AND #CONSTANTS								*
+****************************************************************************************/
+
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/****************************************************************************************
+*									MEMBER FUNCTIONS									*
+****************************************************************************************/
+
+//constructors
+
+#ifdef _WIN32
+MappedFile::MappedFile() : m_open(false), m_data(nullptr), m_size(0), m_file(INVALID_HANDLE_VALUE), m_mapping(nullptr) {}
+#else
+MappedFile::MappedFile() : m_open(false), m_data(nullptr), m_size(0), m_fd(-1) {}
+#endif
+
+MappedFile::MappedFile(const std::string& fileName) : MappedFile() {
+	open(fileName);
+}
+
+
+//public member functions
+
+// Map the whole file read-only, closing any previous mapping first
+bool MappedFile::open(const std::string& fileName) {
+	close();
+
+#ifdef _WIN32
+	m_file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (m_file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(m_file, &fileSize)) {
+		close();
+		return false;
+	}
+	m_size = static_cast<std::size_t>(fileSize.QuadPart);
+
+	if (m_size > 0) {
+		m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (m_mapping == nullptr) {
+			close();
+			return false;
+		}
+		m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+		if (m_data == nullptr) {
+			close();
+			return false;
+		}
+	}
+#else
+	m_fd = ::open(fileName.c_str(), O_RDONLY);
+	if (m_fd < 0) {
+		return false;
+	}
+
+	struct stat fileStat;
+	if (fstat(m_fd, &fileStat) != 0) {
+		close();
+		return false;
+	}
+	m_size = static_cast<std::size_t>(fileStat.st_size);
+
+	if (m_size > 0) {
+		void* view = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+		if (view == MAP_FAILED) {
+			close();
+			return false;
+		}
+		// The loaders walk the file front to back exactly once
+		madvise(view, m_size, MADV_SEQUENTIAL);
+		m_data = static_cast<const char*>(view);
+	}
+#endif
+
+	m_open = true;
+	return true;
+}
+
+// Release the mapping and the underlying file handle
+void MappedFile::close() {
+#ifdef _WIN32
+	if (m_data != nullptr) {
+		UnmapViewOfFile(m_data);
+	}
+	if (m_mapping != nullptr) {
+		CloseHandle(m_mapping);
+	}
+	if (m_file != INVALID_HANDLE_VALUE) {
+		CloseHandle(m_file);
+	}
+	m_mapping = nullptr;
+	m_file = INVALID_HANDLE_VALUE;
+#else
+	if (m_data != nullptr) {
+		munmap(const_cast<char*>(m_data), m_size);
+	}
+	if (m_fd >= 0) {
+		::close(m_fd);
+	}
+	m_fd = -1;
+#endif
+	m_data = nullptr;
+	m_size = 0;
+	m_open = false;
+}
+
+//destructor
+MappedFile::~MappedFile()
+{
+	close();
+}
@@ -0,0 +1,71 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	MappedFile.h
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Read-only memory mapping of a whole file.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+* Other files	:
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*							#GUARDS #INCLUDES AND #CONSTANTS							*
+****************************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+/****************************************************************************************
+*									CLASS DECLARATION									*
+****************************************************************************************/
+
+class MappedFile
+{
+
+public:
+
+	//constructors
+
+	MappedFile();
+
+	explicit MappedFile(const std::string& fileName);
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+
+	//public member functions
+
+	bool open(const std::string& fileName);
+
+	void close();
+
+	bool is_open() const { return m_open; }
+
+	const char* data() const { return m_data; }
+
+	std::size_t size() const { return m_size; }
+
+	//destructor
+	~MappedFile();
+
+private:
+
+	bool m_open; // True once the file has been mapped (an empty file is open with size 0)
+	const char* m_data; // First byte of the mapped view
+	std::size_t m_size; // Size of the mapped view in bytes
+
+#ifdef _WIN32
+	void* m_file; // Win32 file handle
+	void* m_mapping; // Win32 file mapping handle
+#else
+	int m_fd; // POSIX file descriptor
+#endif
+};
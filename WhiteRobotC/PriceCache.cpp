@@ -0,0 +1,169 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	PriceCache.cpp
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Binary columnar cache of a price CSV file, written next to the CSV.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+* Other files	:
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*								#INCLUDES AND #CONSTANTS								*
+****************************************************************************************/
+
+#include "PriceCache.h"
+
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/types.h>
+#include <sys/stat.h>
+#endif
+
+// Version 2 stores the source modification time in nanoseconds, caches of version 1 are rebuilt
+static const char kMagic[8] = { 'W', 'R', 'C', 'A', 'C', 'H', 'E', '2' };
+static const std::uint32_t kByteOrder = 0x01020304;
+
+static_assert(sizeof(PriceCacheHeader) == 64, "The cache header must stay 64 bytes");
+static_assert(sizeof(long long) == 8 && sizeof(double) == 8, "The cache columns are 8 bytes wide");
+
+/****************************************************************************************
+*									MEMBER FUNCTIONS									*
+****************************************************************************************/
+
+//public member functions
+
+std::string PriceCache::cacheFileName(const std::string& sourceFile) {
+	return sourceFile + ".wrc";
+}
+
+bool PriceCache::open(const std::string& sourceFile) {
+	m_file.close();
+	m_rows = 0;
+	m_times = nullptr;
+	m_prices = nullptr;
+
+	std::uint64_t sourceSize, cacheSize;
+	std::int64_t sourceTime, cacheTime;
+	std::string cacheFile = cacheFileName(sourceFile);
+	if (!fileStatus(sourceFile, sourceSize, sourceTime) || !fileStatus(cacheFile, cacheSize, cacheTime) || cacheTime < sourceTime) {
+		return false;
+	}
+	if (!m_file.open(cacheFile) || m_file.size() < sizeof(PriceCacheHeader)) {
+		m_file.close();
+		return false;
+	}
+
+	PriceCacheHeader header;
+	memcpy(&header, m_file.data(), sizeof(header));
+	bool valid = memcmp(header.magic, kMagic, sizeof(kMagic)) == 0 && header.byteOrder == kByteOrder && header.rows > 0
+		&& header.sourceSize == sourceSize && header.sourceTime == sourceTime
+		&& m_file.size() == sizeof(PriceCacheHeader) + header.rows * (sizeof(long long) + sizeof(double));
+	if (!valid) {
+		m_file.close();
+		return false;
+	}
+
+	// The header is 64 bytes and the mapping page aligned, so both columns are 8 byte aligned
+	const long long* times = reinterpret_cast<const long long*>(m_file.data() + sizeof(PriceCacheHeader));
+	const double* prices = reinterpret_cast<const double*>(times + header.rows);
+	if (checksum(times, prices, static_cast<std::size_t>(header.rows)) != header.checksum) {
+		m_file.close();
+		return false;
+	}
+
+	m_rows = static_cast<std::size_t>(header.rows);
+	m_dateFormat = static_cast<int>(header.dateFormat);
+	m_times = times;
+	m_prices = prices;
+	return true;
+}
+
+// Written to a temporary file first so an interrupted run never leaves a truncated cache
+bool PriceCache::write(const std::string& sourceFile, int dateFormat, const std::vector<long long>& times, const std::vector<double>& prices) {
+	PriceCacheHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, kMagic, sizeof(kMagic));
+	header.byteOrder = kByteOrder;
+	header.dateFormat = static_cast<std::uint32_t>(dateFormat);
+	header.rows = prices.size();
+	header.checksum = checksum(times.data(), prices.data(), prices.size());
+	if (times.size() != prices.size() || !fileStatus(sourceFile, header.sourceSize, header.sourceTime)) {
+		return false;
+	}
+
+	std::string cacheFile = cacheFileName(sourceFile);
+	std::string tempFile = cacheFile + ".tmp";
+	FILE* file = fopen(tempFile.c_str(), "wb");
+	if (file == nullptr) {
+		return false;
+	}
+	bool written = fwrite(&header, sizeof(header), 1, file) == 1
+		&& fwrite(times.data(), sizeof(long long), times.size(), file) == times.size()
+		&& fwrite(prices.data(), sizeof(double), prices.size(), file) == prices.size();
+	written = (fclose(file) == 0) && written;
+
+	if (written) {
+		remove(cacheFile.c_str());
+		written = rename(tempFile.c_str(), cacheFile.c_str()) == 0;
+	}
+	if (!written) {
+		remove(tempFile.c_str());
+	}
+	return written;
+}
+
+
+//private member functions
+
+// FNV-1a over 64 bit words of both columns
+std::uint64_t PriceCache::checksum(const long long* times, const double* prices, std::size_t rows) {
+	std::uint64_t hash = 14695981039346656037ULL;
+	for (std::size_t i = 0; i < rows; ++i) {
+		std::uint64_t word;
+		memcpy(&word, &times[i], sizeof(word));
+		hash = (hash ^ word) * 1099511628211ULL;
+		memcpy(&word, &prices[i], sizeof(word));
+		hash = (hash ^ word) * 1099511628211ULL;
+	}
+	return hash;
+}
+
+// Nanoseconds, an edit within the same second as the previous one still changes the time
+bool PriceCache::fileStatus(const std::string& fileName, std::uint64_t& size, std::int64_t& time) {
+#ifdef _WIN32
+	WIN32_FILE_ATTRIBUTE_DATA attributes;
+	if (!GetFileAttributesExA(fileName.c_str(), GetFileExInfoStandard, &attributes)) {
+		return false;
+	}
+	size = (static_cast<std::uint64_t>(attributes.nFileSizeHigh) << 32) | attributes.nFileSizeLow;
+	// 100 ns intervals since 1601
+	std::int64_t intervals = static_cast<std::int64_t>((static_cast<std::uint64_t>(attributes.ftLastWriteTime.dwHighDateTime) << 32)
+		| attributes.ftLastWriteTime.dwLowDateTime);
+	time = (intervals - 116444736000000000LL) * 100;
+#else
+	struct stat fileStat;
+	if (stat(fileName.c_str(), &fileStat) != 0) {
+		return false;
+	}
+	size = static_cast<std::uint64_t>(fileStat.st_size);
+#ifdef __APPLE__
+	const struct timespec& modified = fileStat.st_mtimespec;
+#else
+	const struct timespec& modified = fileStat.st_mtim;
+#endif
+	time = static_cast<std::int64_t>(modified.tv_sec) * 1000000000 + modified.tv_nsec;
+#endif
+	return true;
+}
@@ -0,0 +1,87 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	PriceCache.h
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Binary columnar cache of a price CSV file, written next to the CSV.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+* Other files	:
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*							#GUARDS #INCLUDES AND #CONSTANTS							*
+****************************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "MappedFile.h"
+
+// File layout: a 64 byte header, the int64 epoch seconds column, then the double prices column
+struct PriceCacheHeader
+{
+	char magic[8]; // "WRCACHE2"
+	std::uint32_t byteOrder; // 0x01020304 as written by the producing machine
+	std::uint32_t dateFormat; // Date::Format of the source "time" column
+	std::uint64_t rows; // Number of rows in each column
+	std::uint64_t sourceSize; // Size of the CSV file the cache was built from
+	std::int64_t sourceTime; // Modification time of that CSV file, nanoseconds since the epoch
+	std::uint64_t checksum; // Checksum of both columns
+	std::uint64_t reserved[2];
+};
+
+/****************************************************************************************
+*									CLASS DECLARATION									*
+****************************************************************************************/
+
+class PriceCache
+{
+
+public:
+
+	//constructors
+
+	PriceCache() : m_rows(0), m_dateFormat(0), m_times(nullptr), m_prices(nullptr) {}
+
+
+	//Getters
+
+	std::size_t size() const { return m_rows; }
+
+	int dateFormat() const { return m_dateFormat; }
+
+	const long long* times() const { return m_times; }
+
+	const double* prices() const { return m_prices; }
+
+
+	//public member functions
+
+	static std::string cacheFileName(const std::string& sourceFile);
+
+	// Maps the cache of sourceFile, false if it is missing, older than the CSV or corrupt
+	bool open(const std::string& sourceFile);
+
+	// Writes (or replaces) the cache of sourceFile
+	static bool write(const std::string& sourceFile, int dateFormat, const std::vector<long long>& times, const std::vector<double>& prices);
+
+private:
+
+	static std::uint64_t checksum(const long long* times, const double* prices, std::size_t rows);
+
+	static bool fileStatus(const std::string& fileName, std::uint64_t& size, std::int64_t& time);
+
+	MappedFile m_file; // Mapped cache file
+	std::size_t m_rows; // Number of cached rows
+	int m_dateFormat; // Date::Format of the cached dates
+	const long long* m_times; // Epoch seconds column inside the mapping
+	const double* m_prices; // Prices column inside the mapping
+};
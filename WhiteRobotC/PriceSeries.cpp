@@ -0,0 +1,148 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	PriceSeries.cpp
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Loaded price history with a sorted timestamp index for date slicing.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+* Other files	:
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*								#INCLUDES AND #CONSTANTS								*
+****************************************************************************************/
+
+#include "PriceSeries.h"
+
+#include <iostream>
+#include <algorithm>
+#include <numeric>
+#include <chrono>
+#include "CsvParser.h"
+#include "MappedFile.h"
+#include "PriceCache.h"
+#include "Date.h"
+#include "ThreadPool.h"
+
+using namespace std;
+
+/****************************************************************************************
+*									MEMBER FUNCTIONS									*
+****************************************************************************************/
+
+//public member functions
+
+bool PriceSeries::load(const string& fileName) {
+	auto start = chrono::steady_clock::now();
+	m_times.clear();
+	m_prices.clear();
+
+	PriceCache cache;
+	if (cache.open(fileName)) {
+		cout << endl << " " << PriceCache::cacheFileName(fileName) << " successfully opened." << endl;
+		m_times.assign(cache.times(), cache.times() + cache.size());
+		m_prices.assign(cache.prices(), cache.prices() + cache.size());
+		m_dateFormat = cache.dateFormat();
+	}
+	else if (!loadCsv(fileName)) {
+		return false;
+	}
+	sortByTime();
+
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	cout << "Loaded " << size() << " rows in " << static_cast<long long>(seconds * 1000) << " ms ("
+		<< static_cast<long long>(seconds > 0 ? size() / seconds : 0) << " rows/sec)" << endl;
+	return true;
+}
+
+size_t PriceSeries::lowerBound(long long time) const {
+	return lower_bound(m_times.begin(), m_times.end(), time) - m_times.begin();
+}
+
+PriceView PriceSeries::slice(long long from, long long to) const {
+	size_t first = lowerBound(from);
+	size_t last = max(first, lowerBound(to));
+	return view(first, last);
+}
+
+PriceView PriceSeries::view(size_t first, size_t last) const {
+	PriceView window;
+	window.times = m_times.data() + first;
+	window.prices = m_prices.data() + first;
+	window.size = last - first;
+	window.dateFormat = m_dateFormat;
+	return window;
+}
+
+
+//private member functions
+
+// Parses the memory mapped CSV in place and refreshes its binary cache
+bool PriceSeries::loadCsv(const string& fileName) {
+	MappedFile file(fileName);
+	if (!file.is_open()) {
+		cout << "There was a problem opening the file: " << fileName << endl;
+		return false;
+	}
+	cout << endl << " " << fileName << " successfully opened." << endl;
+	const char* first = file.data();
+	const char* last = first + file.size();
+	const char* body = CsvParser::nextLine(first, last);
+
+	string line(first, body);
+	if (!line.empty() && line.back() == '\n') {
+		line.pop_back();
+	}
+	cout << "The first line is: " << line << endl;
+
+	// Timestamps are parsed once here, every later date comparison is an integer compare
+	m_dateFormat = CsvParser::detectDateFormat(body, last);
+	if (m_dateFormat == Date::UNKNOWN && body != last) {
+		string row(body, CsvParser::nextLine(body, last));
+		if (!row.empty() && row.back() == '\n') {
+			row.pop_back();
+		}
+		cout << "The date of the first data row is in no known format: " << row << endl;
+		return false;
+	}
+	size_t badDates = 0;
+	CsvParser::parseRowsParallel(body, last, m_dateFormat, m_times, m_prices, badDates, ThreadPool::shared());
+	if (badDates > 0) {
+		cout << badDates << " rows skipped, their dates do not match the format of the first row" << endl;
+	}
+
+	// No cache for an empty series, the next load reports the problem again
+	if (m_times.empty()) {
+		cout << "No price rows could be read from: " << fileName << endl;
+		return false;
+	}
+
+	if (PriceCache::write(fileName, m_dateFormat, m_times, m_prices)) {
+		cout << "Binary cache written to: " << PriceCache::cacheFileName(fileName) << endl;
+	}
+	return true;
+}
+
+// The data files are chronological, anything else is reordered once so the index stays valid
+void PriceSeries::sortByTime() {
+	if (is_sorted(m_times.begin(), m_times.end())) {
+		return;
+	}
+	vector<size_t> order(m_times.size());
+	iota(order.begin(), order.end(), 0);
+	stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) { return m_times[a] < m_times[b]; });
+
+	vector<long long> times(order.size());
+	vector<double> prices(order.size());
+	for (size_t i = 0; i < order.size(); i++) {
+		times[i] = m_times[order[i]];
+		prices[i] = m_prices[order[i]];
+	}
+	m_times.swap(times);
+	m_prices.swap(prices);
+}
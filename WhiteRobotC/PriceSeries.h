@@ -0,0 +1,85 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	PriceSeries.h
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Loaded price history with a sorted timestamp index for date slicing.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+* Other files	:
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*							#GUARDS #INCLUDES AND #CONSTANTS							*
+****************************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+// Read-only window over a loaded series, valid while the series is alive and unchanged
+struct PriceView
+{
+	const long long* times; // Epoch seconds of each bar
+	const double* prices; // Closing price of each bar
+	std::size_t size; // Number of bars
+	int dateFormat; // Date::Format used to print the times
+};
+
+/****************************************************************************************
+*									CLASS DECLARATION									*
+****************************************************************************************/
+
+class PriceSeries
+{
+
+public:
+
+	//constructors
+
+	PriceSeries() : m_dateFormat(0) {}
+
+
+	//Getters
+
+	std::size_t size() const { return m_prices.size(); }
+
+	int dateFormat() const { return m_dateFormat; }
+
+	const std::vector<long long>& times() const { return m_times; }
+
+	const std::vector<double>& prices() const { return m_prices; }
+
+
+	//public member functions
+
+	// Loads a price file, from its binary cache when the cache is up to date
+	bool load(const std::string& fileName);
+
+	// Index of the first bar at or after time
+	std::size_t lowerBound(long long time) const;
+
+	// Bars with from <= time < to
+	PriceView slice(long long from, long long to) const;
+
+	// Bars [first, last)
+	PriceView view(std::size_t first, std::size_t last) const;
+
+	PriceView all() const { return view(0, size()); }
+
+private:
+
+	bool loadCsv(const std::string& fileName);
+
+	void sortByTime();
+
+	std::vector<long long> m_times; // Sorted epoch seconds of every bar
+	std::vector<double> m_prices; // Closing prices aligned with m_times
+	int m_dateFormat; // Date::Format of the source file
+};
@@ -49,6 +49,17 @@ void RobotMenu::readLine(string& description) {
 	getline(cin, description);
 }
 
+// Ask which backtester runs the simulations of a sweep, both write the same rows
+SweepRunner::Engine RobotMenu::readEngine() {
+	int engine = 0;
+	cout << "- Backtester, 0 event driven, 1 lockstep batches of robots or 2 one robot after another (Example:0): " << endl;
+	cin >> engine;
+	if (engine == 2) {
+		return SweepRunner::SUMMARY;
+	}
+	return engine == 1 ? SweepRunner::LOCKSTEP : SweepRunner::EVENTS;
+}
+
 
 // Test if the data file is correct and display content
 void RobotMenu::testData() {
@@ -148,6 +159,10 @@ void RobotMenu::randomWhite() {
 	double max_stopLoss;
 
 	double intialCash = 1000;
+	int sampling = 0;
+	unsigned int haltonSeed = 1;
+	unsigned long long firstPoint = 0;
+	PruningRule pruning;
 
 	clearConsole();
 	cout << "****************************************************************************" << endl;
@@ -185,17 +200,25 @@ void RobotMenu::randomWhite() {
 	cin >> max_stopLoss;
 	cout << "- Number of simulations to execute: " << endl;
 	cin >> testNumber;
+	cout << "- Sampling, 0 random or 1 quasi-random Halton sequence (Example:0): " << endl;
+	cin >> sampling;
+	if (sampling == 1) {
+		cout << "- Halton seed, the same for every part of a sweep (Example:1): " << endl;
+		cin >> haltonSeed;
+		cout << "- First point of the sequence, where the previous part ended (Example:0): " << endl;
+		cin >> firstPoint;
+	}
+	cout << "- Points between checks to stop losing robots early, 0 never stops them (Example:0): " << endl;
+	cin >> pruning.checkpointPoints;
+	if (pruning.enabled()) {
+		cout << "- Lowest portfolio value at a check (Example:500): " << endl;
+		cin >> pruning.minValue;
+		cout << "- Largest loss from the best check, as a fraction (Example:0.5): " << endl;
+		cin >> pruning.maxDrawdown;
+	}
+	SweepRunner::Engine engine = readEngine();
 	cout << "- All simulations are done with an initial investment of 1000 " << endl << endl;
 	
-	int maPointsS_long, maPointsM_long, maPointsL_long, mode_long, maPointsS_short, maPointsM_short, maPointsL_short, mode_short;
-	double slopeMin_long, slopeMin_short;
-
-	int slopePoints;
-	double stopLoss;
-
-	random_device rd;     // only used once to initialise (seed) engine
-	mt19937 rng(rd());    // random-number engine used (Mersenne-Twister)
-
 	uniform_int_distribution<int> generator_maPointsS_long(2, max_maPointsS_long);
 	uniform_int_distribution<int> generator_maPointsM_long(2, max_maPointsM_long);
 	uniform_int_distribution<int> generator_maPointsL_long(2, max_maPointsL_long);
@@ -213,31 +236,45 @@ void RobotMenu::randomWhite() {
 	WhiteRobot robot;
 	robot.loadData("/Users/shankar/Desktop/WhiteRobotC/WhiteRobotC/index_data.csv");
 
-	for (int i = 0; i < testNumber; i++)
-	{
-		maPointsS_long = generator_maPointsS_long(rng);
-		maPointsM_long = generator_maPointsM_long(rng);
-		maPointsL_long = generator_maPointsL_long(rng);
-		slopeMin_long = floor((generator_slopeMin_long(rng) * 10000) + .5) / 10000;
-		mode_long = generator_mode(rng);
-
-		maPointsS_short = generator_maPointsS_short(rng);
-		maPointsM_short = generator_maPointsM_short(rng);
-		maPointsL_short = generator_maPointsL_short(rng);
-		slopeMin_short = floor((generator_slopeMin_short(rng) * 10000) + .5) / 10000;
-		mode_short = generator_mode(rng);
-
-		slopePoints = generator_slopePoints(rng);
-		stopLoss = floor((generator_stopLoss(rng) * 10000) + .5) / 10000;
-		
-		robot.setParameters(maPointsS_long, maPointsM_long, maPointsL_long, slopeMin_long, mode_long, maPointsS_short, maPointsM_short, maPointsL_short, slopeMin_short, mode_short, slopePoints, stopLoss);
-		robot.RunStrategy(intialCash);
-		robot.saveSimulation("/Users/shankar/Desktop/WhiteRobotC/WhiteRobotC/simulations.csv");
-
-		if ((i + 1) % 100 == 0) {
-			cout << "Simulation number: " << i+1 <<endl;
-		}
-
+	// Simulation i draws its parameters from its own engine seeded with (seed, i)
+	SweepRunner::Sampler sampler = [=](mt19937& rng) mutable {
+		RobotParameters parameters;
+		parameters.maPointsS_long = generator_maPointsS_long(rng);
+		parameters.maPointsM_long = generator_maPointsM_long(rng);
+		parameters.maPointsL_long = generator_maPointsL_long(rng);
+		parameters.slopeMin_long = floor((generator_slopeMin_long(rng) * 10000) + .5) / 10000;
+		parameters.mode_long = generator_mode(rng);
+
+		parameters.maPointsS_short = generator_maPointsS_short(rng);
+		parameters.maPointsM_short = generator_maPointsM_short(rng);
+		parameters.maPointsL_short = generator_maPointsL_short(rng);
+		parameters.slopeMin_short = floor((generator_slopeMin_short(rng) * 10000) + .5) / 10000;
+		parameters.mode_short = generator_mode(rng);
+
+		parameters.slopePoints = generator_slopePoints(rng);
+		parameters.stopLoss = floor((generator_stopLoss(rng) * 10000) + .5) / 10000;
+		return parameters;
+	};
+
+	SweepRunner runner(robot, ThreadPool::shared());
+	runner.setPruning(pruning);
+	runner.setEngine(engine);
+	if (sampling == 1) {
+		// Simulation i takes point firstPoint + i of the sequence
+		ParameterRange range;
+		range.lowest = { 2, 2, 2, 0, 0, 2, 2, 2, 0, 0, 2, 0 };
+		range.highest = { max_maPointsS_long, max_maPointsM_long, max_maPointsL_long, max_slopeMin_long, 7, max_maPointsS_short,
+			max_maPointsM_short, max_maPointsL_short, max_slopeMin_short, 7, max_slopePoints, max_stopLoss };
+		HaltonSampler halton(haltonSeed);
+		SweepRunner::IndexSampler points = [&halton, &range, firstPoint](int i) { return halton.draw(range, firstPoint + i); };
+		runner.run(points, testNumber, intialCash, "/Users/shankar/Desktop/WhiteRobotC/WhiteRobotC/simulations.csv");
+		cout << "The next part of the sweep starts at point " << firstPoint + testNumber << endl;
+	}
+	else {
+		random_device rd;
+		unsigned int seed = rd();
+		cout << "Sweep seed: " << seed << endl;
+		runner.run(sampler, testNumber, intialCash, seed, "/Users/shankar/Desktop/WhiteRobotC/WhiteRobotC/simulations.csv");
 	}
 
 	menuPause();
@@ -256,6 +293,10 @@ void RobotMenu::closedRandomWhite() {
 	double min_stopLoss, max_stopLoss;
 
 	double intialCash = 1000;
+	int sampling = 0;
+	unsigned int haltonSeed = 1;
+	unsigned long long firstPoint = 0;
+	PruningRule pruning;
 
 	clearConsole();
 	cout << "****************************************************************************" << endl;
@@ -311,17 +352,25 @@ void RobotMenu::closedRandomWhite() {
 	cin >> max_stopLoss;
 	cout << "- Number of simulations to execute: " << endl;
 	cin >> testNumber;
+	cout << "- Sampling, 0 random or 1 quasi-random Halton sequence (Example:0): " << endl;
+	cin >> sampling;
+	if (sampling == 1) {
+		cout << "- Halton seed, the same for every part of a sweep (Example:1): " << endl;
+		cin >> haltonSeed;
+		cout << "- First point of the sequence, where the previous part ended (Example:0): " << endl;
+		cin >> firstPoint;
+	}
+	cout << "- Points between checks to stop losing robots early, 0 never stops them (Example:0): " << endl;
+	cin >> pruning.checkpointPoints;
+	if (pruning.enabled()) {
+		cout << "- Lowest portfolio value at a check (Example:500): " << endl;
+		cin >> pruning.minValue;
+		cout << "- Largest loss from the best check, as a fraction (Example:0.5): " << endl;
+		cin >> pruning.maxDrawdown;
+	}
+	SweepRunner::Engine engine = readEngine();
 	cout << "All simulations are done with an initial cash of 1000 " << endl;
 
-	int maPointsS_long, maPointsM_long, maPointsL_long, mode_long, maPointsS_short, maPointsM_short, maPointsL_short, mode_short;
-	double slopeMin_long, slopeMin_short;
-
-	int slopePoints;
-	double stopLoss;
-
-	random_device rd;     // only used once to initialise (seed) engine
-	mt19937 rng(rd());    // random-number engine used (Mersenne-Twister)
-
 	uniform_int_distribution<int> generator_maPointsS_long(min_maPointsS_long, max_maPointsS_long);
 	uniform_int_distribution<int> generator_maPointsM_long(min_maPointsM_long, max_maPointsM_long);
 	uniform_int_distribution<int> generator_maPointsL_long(min_maPointsL_long, max_maPointsL_long);
@@ -339,32 +388,47 @@ void RobotMenu::closedRandomWhite() {
 	WhiteRobot robot;
 	robot.loadData("/Users/shankar/Desktop/WhiteRobotC/WhiteRobotC/index_data.csv");
 
-	for (int i = 0; i < testNumber; i++)
-	{
-		maPointsS_long = generator_maPointsS_long(rng);
-		maPointsM_long = generator_maPointsM_long(rng);
-		maPointsL_long = generator_maPointsL_long(rng);
-		slopeMin_long = floor((generator_slopeMin_long(rng) * 10000) + .5) / 10000;
-		mode_long = generator_mode(rng);
-
-		maPointsS_short = generator_maPointsS_short(rng);
-		maPointsM_short = generator_maPointsM_short(rng);
-		maPointsL_short = generator_maPointsL_short(rng);
-		slopeMin_short = floor((generator_slopeMin_short(rng) * 10000) + .5) / 10000;
-		mode_short = generator_mode(rng);
-
-		slopePoints = generator_slopePoints(rng);
-		stopLoss = floor((generator_stopLoss(rng) * 10000) + .5) / 10000;
-
-		robot.setParameters(maPointsS_long, maPointsM_long, maPointsL_long, slopeMin_long, mode_long, maPointsS_short, maPointsM_short, maPointsL_short, slopeMin_short, mode_short, slopePoints, stopLoss);
-		robot.RunStrategy(intialCash);
-		robot.saveSimulation("/Users/shankar/Desktop/WhiteRobotC/WhiteRobotC/simulations.csv");
-
-		if ((i + 1) % 100 == 0) {
-			cout << "Simulation number: " << i + 1 << endl;
-		}
-
+	SweepRunner::Sampler sampler = [=](mt19937& rng) mutable {
+		RobotParameters parameters;
+		parameters.maPointsS_long = generator_maPointsS_long(rng);
+		parameters.maPointsM_long = generator_maPointsM_long(rng);
+		parameters.maPointsL_long = generator_maPointsL_long(rng);
+		parameters.slopeMin_long = floor((generator_slopeMin_long(rng) * 10000) + .5) / 10000;
+		parameters.mode_long = generator_mode(rng);
+
+		parameters.maPointsS_short = generator_maPointsS_short(rng);
+		parameters.maPointsM_short = generator_maPointsM_short(rng);
+		parameters.maPointsL_short = generator_maPointsL_short(rng);
+		parameters.slopeMin_short = floor((generator_slopeMin_short(rng) * 10000) + .5) / 10000;
+		parameters.mode_short = generator_mode(rng);
+
+		parameters.slopePoints = generator_slopePoints(rng);
+		parameters.stopLoss = floor((generator_stopLoss(rng) * 10000) + .5) / 10000;
+		return parameters;
+	};
+
+	SweepRunner runner(robot, ThreadPool::shared());
+	runner.setPruning(pruning);
+	runner.setEngine(engine);
+	if (sampling == 1) {
+		// Simulation i takes point firstPoint + i of the sequence
+		ParameterRange range;
+		range.lowest = { min_maPointsS_long, min_maPointsM_long, min_maPointsL_long, min_slopeMin_long, 0, min_maPointsS_short,
+			min_maPointsM_short, min_maPointsL_short, min_slopeMin_short, 0, min_slopePoints, min_stopLoss };
+		range.highest = { max_maPointsS_long, max_maPointsM_long, max_maPointsL_long, max_slopeMin_long, 7, max_maPointsS_short,
+			max_maPointsM_short, max_maPointsL_short, max_slopeMin_short, 7, max_slopePoints, max_stopLoss };
+		HaltonSampler halton(haltonSeed);
+		SweepRunner::IndexSampler points = [&halton, &range, firstPoint](int i) { return halton.draw(range, firstPoint + i); };
+		runner.run(points, testNumber, intialCash, "/Users/shankar/Desktop/WhiteRobotC/WhiteRobotC/simulations.csv");
+		cout << "The next part of the sweep starts at point " << firstPoint + testNumber << endl;
 	}
+	else {
+		random_device rd;
+		unsigned int seed = rd();
+		cout << "Sweep seed: " << seed << endl;
+		runner.run(sampler, testNumber, intialCash, seed, "/Users/shankar/Desktop/WhiteRobotC/WhiteRobotC/simulations.csv");
+	}
+
 	menuPause();
 }
 
@@ -441,17 +505,9 @@ void RobotMenu::FixedBrainRandomWhite() {
 	cin >> max_stopLoss;
 	cout << "- Number of simulations to execute: " << endl;
 	cin >> testNumber;
+	SweepRunner::Engine engine = readEngine();
 	cout << "- All simulations are done with an initial cash of 1000 " << endl;
 
-	int maPointsS_long, maPointsM_long, maPointsL_long, maPointsS_short, maPointsM_short, maPointsL_short;
-	double slopeMin_long, slopeMin_short;
-
-	int slopePoints;
-	double stopLoss;
-
-	random_device rd;     // only used once to initialise (seed) engine
-	mt19937 rng(rd());    // random-number engine used (Mersenne-Twister)
-
 	uniform_int_distribution<int> generator_maPointsS_long(min_maPointsS_long, max_maPointsS_long);
 	uniform_int_distribution<int> generator_maPointsM_long(min_maPointsM_long, max_maPointsM_long);
 	uniform_int_distribution<int> generator_maPointsL_long(min_maPointsL_long, max_maPointsL_long);
@@ -468,33 +524,423 @@ void RobotMenu::FixedBrainRandomWhite() {
 	WhiteRobot robot;
 	robot.loadData("/Users/shankar/Desktop/WhiteRobotC/WhiteRobotC/index_data.csv");
 
-	for (int i = 0; i < testNumber; i++)
-	{
-		maPointsS_long = generator_maPointsS_long(rng);
-		maPointsM_long = generator_maPointsM_long(rng);
-		maPointsL_long = generator_maPointsL_long(rng);
-		slopeMin_long = floor((generator_slopeMin_long(rng) * 10000) + .5) / 10000;
+	SweepRunner::Sampler sampler = [=](mt19937& rng) mutable {
+		RobotParameters parameters;
+		parameters.maPointsS_long = generator_maPointsS_long(rng);
+		parameters.maPointsM_long = generator_maPointsM_long(rng);
+		parameters.maPointsL_long = generator_maPointsL_long(rng);
+		parameters.slopeMin_long = floor((generator_slopeMin_long(rng) * 10000) + .5) / 10000;
+		parameters.mode_long = mode_long;
+
+		parameters.maPointsS_short = generator_maPointsS_short(rng);
+		parameters.maPointsM_short = generator_maPointsM_short(rng);
+		parameters.maPointsL_short = generator_maPointsL_short(rng);
+		parameters.slopeMin_short = floor((generator_slopeMin_short(rng) * 10000) + .5) / 10000;
+		parameters.mode_short = mode_short;
+
+		parameters.slopePoints = generator_slopePoints(rng);
+		parameters.stopLoss = floor((generator_stopLoss(rng) * 10000) + .5) / 10000;
+		return parameters;
+	};
+
+	random_device rd;
+	unsigned int seed = rd();
+	cout << "Sweep seed: " << seed << endl;
+
+	SweepRunner runner(robot, ThreadPool::shared());
+	runner.setEngine(engine);
+	runner.run(sampler, testNumber, intialCash, seed, "/Users/shankar/Desktop/WhiteRobotC/WhiteRobotC/simulations.csv");
 
+	menuPause();
 
-		maPointsS_short = generator_maPointsS_short(rng);
-		maPointsM_short = generator_maPointsM_short(rng);
-		maPointsL_short = generator_maPointsL_short(rng);
-		slopeMin_short = floor((generator_slopeMin_short(rng) * 10000) + .5) / 10000;
+}
 
-		slopePoints = generator_slopePoints(rng);
-		stopLoss = floor((generator_stopLoss(rng) * 10000) + .5) / 10000;
+// One White Robot simulated for a range of stop-loss values in a single pass
+void RobotMenu::stopLossWhite() {
 
-		robot.setParameters(maPointsS_long, maPointsM_long, maPointsL_long, slopeMin_long, mode_long, maPointsS_short, maPointsM_short, maPointsL_short, slopeMin_short, mode_short, slopePoints, stopLoss);
-		robot.RunStrategy(intialCash);
-		robot.saveSimulation("/Users/shankar/Desktop/WhiteRobotC/WhiteRobotC/simulations.csv");
+	RobotParameters parameters;
+	double min_stopLoss, max_stopLoss;
+	int stopLossNumber;
+	double intialCash = 1000;
 
-		if ((i + 1) % 100 == 0) {
-			cout << "Simulation number: " << i + 1 << endl;
-		}
+	clearConsole();
+	cout << "****************************************************************************" << endl;
+	cout << "			7. White Robot over a range of stop-loss values " << endl;
+	cout << "****************************************************************************" << endl << endl;
+	cout << " Enter the parameters of the simulation:" << endl;
+	cout << " (1 month is about 500 points for H1): " << endl;
 
+	cout << endl << "Long trades Strategy parameters: " << endl;
+	cout << " - Small window points size (Example:14): " << endl;
+	cin >> parameters.maPointsS_long;
+	cout << " - Medium window points size (Example:21): " << endl;
+	cin >> parameters.maPointsM_long;
+	cout << " - Large window points size (Example:40): " << endl;
+	cin >> parameters.maPointsL_long;
+	cout << " - Minimum slope to establish a trend (Example:0.01): " << endl;
+	cin >> parameters.slopeMin_long;
+	cout << "- Logic Mode for Long trades [0-7]: " << endl;
+	cin >> parameters.mode_long;
+
+	cout << endl << "Short trades Strategy parameters: " << endl;
+	cout << " - Small window points size (Example:14): " << endl;
+	cin >> parameters.maPointsS_short;
+	cout << " - Medium window points size (Example:21): " << endl;
+	cin >> parameters.maPointsM_short;
+	cout << " - Large window points size (Example:40): " << endl;
+	cin >> parameters.maPointsL_short;
+	cout << " - Minimum slope to establish a trend (Example:0.01): " << endl;
+	cin >> parameters.slopeMin_short;
+	cout << "- Logic Mode for Short trades [0-7]: " << endl;
+	cin >> parameters.mode_short;
+
+	cout << endl << "General Strategy parameters: " << endl;
+	cout << "- Number of points to use for calculating the Slope (Example:300)" << endl;
+	cin >> parameters.slopePoints;
+	cout << "- Minimum Stop-loss parameter (Example:0.01): " << endl;
+	cin >> min_stopLoss;
+	cout << "- Maximum Stop-loss parameter (Example:0.05): " << endl;
+	cin >> max_stopLoss;
+	cout << "- Number of stop-loss values, evenly spaced (Example:41): " << endl;
+	cin >> stopLossNumber;
+	cout << "- All simulations are done with an initial cash of 1000 " << endl;
+
+	vector<double> stopLosses;
+	for (int i = 0; i < stopLossNumber; i++) {
+		double stopLoss = stopLossNumber == 1 ? min_stopLoss : min_stopLoss + (max_stopLoss - min_stopLoss) * i / (stopLossNumber - 1);
+		stopLosses.push_back(floor((stopLoss * 10000) + .5) / 10000);
+	}
+
+	WhiteRobot robot;
+	robot.loadData("/Users/shankar/Desktop/WhiteRobotC/WhiteRobotC/index_data.csv");
+	robot.setParameters(parameters);
+	vector<StrategyStatistics> results = robot.RunStrategyStopLosses(intialCash, stopLosses);
+
+	ofstream file_out("/Users/shankar/Desktop/WhiteRobotC/WhiteRobotC/simulations.csv", ios_base::app);
+	for (size_t i = 0; i < stopLosses.size(); i++) {
+		parameters.stopLoss = stopLosses[i];
+		robot.setParameters(parameters);
+		robot.setStatistics(results[i]);
+		robot.writeSimulation(file_out);
 	}
+	cout << endl << stopLosses.size() << " simulations added to simulations.csv" << endl;
+
 	menuPause();
+}
+
+// Parameters of random White Robots chosen on rolling training periods and tested on the following ones
+void RobotMenu::walkForwardWhite() {
 
+	int max_maPointsS_long, max_maPointsM_long, max_maPointsL_long, max_maPointsS_short, max_maPointsM_short, max_maPointsL_short;
+	double max_slopeMin_long, max_slopeMin_short;
+
+	int max_slopePoints, testNumber, trainPoints, testPoints;
+	double max_stopLoss;
+
+	double intialCash = 1000;
+
+	clearConsole();
+	cout << "****************************************************************************" << endl;
+	cout << "			8. Walk-forward optimisation of random White Robots " << endl;
+	cout << "****************************************************************************" << endl << endl;
+	cout << " Enter the parameters for the simulations:" << endl;
+	cout << " (1 month is about 500 points for H1): " << endl << endl;
+
+	cout << endl << "Long trades Strategy parameters: " << endl;
+	cout << " - Small window maximum points size (Example:30): " << endl;
+	cin >> max_maPointsS_long;
+	cout << " - Medium window maximum points size (Example:40): " << endl;
+	cin >> max_maPointsM_long;
+	cout << " - Large window maximum points size (Example:60): " << endl;
+	cin >> max_maPointsL_long;
+	cout << " - Maximum slope to establish a trend (Example:0.1): " << endl;
+	cin >> max_slopeMin_long;
+	
+
+	cout << endl << "Short trades Strategy parameters: " << endl;
+	cout << " - Small window maximum points size (Example:30): " << endl;
+	cin >> max_maPointsS_short;
+	cout << " - Medium window maximum points size (Example:40): " << endl;
+	cin >> max_maPointsM_short;
+	cout << " - Large window maximum points size (Example:60): " << endl;
+	cin >> max_maPointsL_short;
+	cout << " - Maximum slope to establish a trend (Example:0.1): " << endl;
+	cin >> max_slopeMin_short;
+	
+
+	cout << endl << "General Strategy parameters: " << endl;
+	cout << "- Maximum number of points to use for calculating the Slope (Example:500)" << endl;
+	cin >> max_slopePoints;
+	cout << "- Maximum Stop-loss parameter (Example:0.1): " << endl;
+	cin >> max_stopLoss;
+	cout << "- Number of random robots to choose from in every training period: " << endl;
+	cin >> testNumber;
+
+	cout << endl << "Walk-forward parameters: " << endl;
+	cout << "- Number of points of every training period (Example:6000): " << endl;
+	cin >> trainPoints;
+	cout << "- Number of points of every test period, the next training starts that many points later (Example:1500): " << endl;
+	cin >> testPoints;
+	cout << "- All simulations are done with an initial investment of 1000 " << endl << endl;
+	
+	uniform_int_distribution<int> generator_maPointsS_long(2, max_maPointsS_long);
+	uniform_int_distribution<int> generator_maPointsM_long(2, max_maPointsM_long);
+	uniform_int_distribution<int> generator_maPointsL_long(2, max_maPointsL_long);
+	uniform_real_distribution<double> generator_slopeMin_long(0, max_slopeMin_long);
+
+	uniform_int_distribution<int> generator_maPointsS_short(2, max_maPointsS_short);
+	uniform_int_distribution<int> generator_maPointsM_short(2, max_maPointsM_short);
+	uniform_int_distribution<int> generator_maPointsL_short(2, max_maPointsL_short);
+	uniform_real_distribution<double> generator_slopeMin_short(0, max_slopeMin_short);
+
+	uniform_int_distribution<int> generator_mode(0,7);
+	uniform_int_distribution<int> generator_slopePoints(2, max_slopePoints);
+	uniform_real_distribution<double> generator_stopLoss(0, max_stopLoss);
+
+	WhiteRobot robot;
+	robot.loadData("/Users/shankar/Desktop/WhiteRobotC/WhiteRobotC/index_data.csv");
+
+	// Robot i draws its parameters from its own engine seeded with (seed, i)
+	SweepRunner::Sampler sampler = [=](mt19937& rng) mutable {
+		RobotParameters parameters;
+		parameters.maPointsS_long = generator_maPointsS_long(rng);
+		parameters.maPointsM_long = generator_maPointsM_long(rng);
+		parameters.maPointsL_long = generator_maPointsL_long(rng);
+		parameters.slopeMin_long = floor((generator_slopeMin_long(rng) * 10000) + .5) / 10000;
+		parameters.mode_long = generator_mode(rng);
+
+		parameters.maPointsS_short = generator_maPointsS_short(rng);
+		parameters.maPointsM_short = generator_maPointsM_short(rng);
+		parameters.maPointsL_short = generator_maPointsL_short(rng);
+		parameters.slopeMin_short = floor((generator_slopeMin_short(rng) * 10000) + .5) / 10000;
+		parameters.mode_short = generator_mode(rng);
+
+		parameters.slopePoints = generator_slopePoints(rng);
+		parameters.stopLoss = floor((generator_stopLoss(rng) * 10000) + .5) / 10000;
+		return parameters;
+	};
+
+	random_device rd;
+	unsigned int seed = rd();
+	cout << "Sweep seed: " << seed << endl;
+
+	WalkForward walkForward(robot, ThreadPool::shared());
+	walkForward.run(sampler, testNumber, trainPoints, testPoints, intialCash, seed, "/Users/shankar/Desktop/WhiteRobotC/WhiteRobotC/walk_forward.csv");
+
+	menuPause();
+}
+
+// White Robots with parameters in closed intervals bred from the best ones of every generation
+void RobotMenu::geneticWhite() {
+
+	int min_maPointsS_long, min_maPointsM_long, min_maPointsL_long, min_maPointsS_short, min_maPointsM_short, min_maPointsL_short;
+	int max_maPointsS_long, max_maPointsM_long, max_maPointsL_long, max_maPointsS_short, max_maPointsM_short, max_maPointsL_short;
+	double min_slopeMin_long, min_slopeMin_short;
+	double max_slopeMin_long, max_slopeMin_short;
+
+	int min_slopePoints, max_slopePoints, testNumber, population;
+	double min_stopLoss, max_stopLoss, targetReturn;
+
+	double intialCash = 1000;
+
+	clearConsole();
+	cout << "****************************************************************************" << endl;
+	cout << "			9. Evolutionary search of White Robots with Closed range " << endl;
+	cout << "****************************************************************************" << endl << endl;
+	cout << " Enter the parameters for the simulations:" << endl;
+	cout << " (1 month is about 500 points for H1): " << endl << endl;
+
+	cout << endl << "Long trades Strategy parameters: " << endl;
+	cout << "- Minimum small window points size (Example:2) min 2: " << endl;
+	cin >> min_maPointsS_long;
+	cout << "- Maximum small window points size (Example:20): " << endl;
+	cin >> max_maPointsS_long;
+	cout << "- Minimum medium window points size (Example:10) min 2: " << endl;
+	cin >> min_maPointsM_long;
+	cout << "- Maximum medium window points size (Example:40): " << endl;
+	cin >> max_maPointsM_long;
+	cout << "- Minimum large window points size (Example:15) min 2: " << endl;
+	cin >> min_maPointsL_long;
+	cout << "- Maximum large window points size (Example:60): " << endl;
+	cin >> max_maPointsL_long;
+	cout << "- Minimum slope to establish a trend (Example:0.01): " << endl;
+	cin >> min_slopeMin_long;
+	cout << "- Maximum slope to establish a trend (Example:0.05): " << endl;
+	cin >> max_slopeMin_long;
+
+	cout << endl << "Short trades Strategy parameters: " << endl;
+	cout << "- Minimum small window points size (Example:2) min 2: " << endl;
+	cin >> min_maPointsS_short;
+	cout << "- Maximum small window points size (Example:20): " << endl;
+	cin >> max_maPointsS_short;
+	cout << "- Minimum medium window points size (Example:10) min 2: " << endl;
+	cin >> min_maPointsM_short;
+	cout << "- Maximum medium window points size (Example:40): " << endl;
+	cin >> max_maPointsM_short;
+	cout << "- Minimum large window points size (Example:15) min 2: " << endl;
+	cin >> min_maPointsL_short;
+	cout << "- Maximum large window points size (Example:60): " << endl;
+	cin >> max_maPointsL_short;
+	cout << "- Minimum slope to establish a trend (Example:0.01): " << endl;
+	cin >> min_slopeMin_short;
+	cout << "- Maximum slope to establish a trend (Example:0.05): " << endl;
+	cin >> max_slopeMin_short;
+
+	cout << endl << "General Strategy parameters: " << endl;
+	cout << "- Minimum number of points to use for calculating the Slope (Example:50): " << endl;
+	cin >> min_slopePoints;
+	cout << "- Maximum number of points to use for calculating the Slope (Example:500): " << endl;
+	cin >> max_slopePoints;
+	cout << "- Minimum Stop-loss parameter (Example:0.01): " << endl;
+	cin >> min_stopLoss;
+	cout << "- Maximum Stop-loss parameter (Example:0.05): " << endl;
+	cin >> max_stopLoss;
+	cout << "- Maximum number of simulations to execute: " << endl;
+	cin >> testNumber;
+	cout << "- Robots per generation (Example:64): " << endl;
+	cin >> population;
+	cout << "- Portfolio return in percent that stops the search (Example:400): " << endl;
+	cin >> targetReturn;
+	cout << "All simulations are done with an initial cash of 1000 " << endl;
+
+	ParameterRange range;
+	range.lowest = { min_maPointsS_long, min_maPointsM_long, min_maPointsL_long, min_slopeMin_long, 0, min_maPointsS_short,
+		min_maPointsM_short, min_maPointsL_short, min_slopeMin_short, 0, min_slopePoints, min_stopLoss };
+	range.highest = { max_maPointsS_long, max_maPointsM_long, max_maPointsL_long, max_slopeMin_long, 7, max_maPointsS_short,
+		max_maPointsM_short, max_maPointsL_short, max_slopeMin_short, 7, max_slopePoints, max_stopLoss };
+
+	WhiteRobot robot;
+	robot.loadData("/Users/shankar/Desktop/WhiteRobotC/WhiteRobotC/index_data.csv");
+
+	random_device rd;
+	unsigned int seed = rd();
+	cout << "Search seed: " << seed << endl;
+
+	GeneticOptimizer optimizer(robot, ThreadPool::shared());
+	optimizer.setPopulation(population);
+	int simulations = optimizer.run(range, testNumber, targetReturn, intialCash, seed,
+		"/Users/shankar/Desktop/WhiteRobotC/WhiteRobotC/simulations.csv");
+
+	robot.setParameters(optimizer.getBest());
+	robot.setStatistics(optimizer.getBestStatistics());
+	cout << endl << simulations << " simulations added to simulations.csv, the best one:" << endl;
+	robot.writeSimulation(cout);
+
+	menuPause();
+}
+
+// Random White Robots with parameters in closed intervals screened on growing parts of the data
+void RobotMenu::halvingWhite() {
+
+	int min_maPointsS_long, min_maPointsM_long, min_maPointsL_long, min_maPointsS_short, min_maPointsM_short, min_maPointsL_short;
+	int max_maPointsS_long, max_maPointsM_long, max_maPointsL_long, max_maPointsS_short, max_maPointsM_short, max_maPointsL_short;
+	double min_slopeMin_long, min_slopeMin_short;
+	double max_slopeMin_long, max_slopeMin_short;
+
+	int min_slopePoints, max_slopePoints, testNumber, rounds, eta;
+	double min_stopLoss, max_stopLoss;
+
+	double intialCash = 1000;
+
+	clearConsole();
+	cout << "****************************************************************************" << endl;
+	cout << "			10. Successive halving of random White Robots with Closed range " << endl;
+	cout << "****************************************************************************" << endl << endl;
+	cout << " Enter the parameters for the simulations:" << endl;
+	cout << " (1 month is about 500 points for H1): " << endl << endl;
+
+	cout << endl << "Long trades Strategy parameters: " << endl;
+	cout << "- Minimum small window points size (Example:2) min 2: " << endl;
+	cin >> min_maPointsS_long;
+	cout << "- Maximum small window points size (Example:20): " << endl;
+	cin >> max_maPointsS_long;
+	cout << "- Minimum medium window points size (Example:10) min 2: " << endl;
+	cin >> min_maPointsM_long;
+	cout << "- Maximum medium window points size (Example:40): " << endl;
+	cin >> max_maPointsM_long;
+	cout << "- Minimum large window points size (Example:15) min 2: " << endl;
+	cin >> min_maPointsL_long;
+	cout << "- Maximum large window points size (Example:60): " << endl;
+	cin >> max_maPointsL_long;
+	cout << "- Minimum slope to establish a trend (Example:0.01): " << endl;
+	cin >> min_slopeMin_long;
+	cout << "- Maximum slope to establish a trend (Example:0.05): " << endl;
+	cin >> max_slopeMin_long;
+
+	cout << endl << "Short trades Strategy parameters: " << endl;
+	cout << "- Minimum small window points size (Example:2) min 2: " << endl;
+	cin >> min_maPointsS_short;
+	cout << "- Maximum small window points size (Example:20): " << endl;
+	cin >> max_maPointsS_short;
+	cout << "- Minimum medium window points size (Example:10) min 2: " << endl;
+	cin >> min_maPointsM_short;
+	cout << "- Maximum medium window points size (Example:40): " << endl;
+	cin >> max_maPointsM_short;
+	cout << "- Minimum large window points size (Example:15) min 2: " << endl;
+	cin >> min_maPointsL_short;
+	cout << "- Maximum large window points size (Example:60): " << endl;
+	cin >> max_maPointsL_short;
+	cout << "- Minimum slope to establish a trend (Example:0.01): " << endl;
+	cin >> min_slopeMin_short;
+	cout << "- Maximum slope to establish a trend (Example:0.05): " << endl;
+	cin >> max_slopeMin_short;
+
+	cout << endl << "General Strategy parameters: " << endl;
+	cout << "- Minimum number of points to use for calculating the Slope (Example:50): " << endl;
+	cin >> min_slopePoints;
+	cout << "- Maximum number of points to use for calculating the Slope (Example:500): " << endl;
+	cin >> max_slopePoints;
+	cout << "- Minimum Stop-loss parameter (Example:0.01): " << endl;
+	cin >> min_stopLoss;
+	cout << "- Maximum Stop-loss parameter (Example:0.05): " << endl;
+	cin >> max_stopLoss;
+	cout << "- Number of simulations to execute: " << endl;
+	cin >> testNumber;
+	cout << "- Number of rounds, the last one over all the data, fewer rounds keep more of the best robots (Example:3): " << endl;
+	cin >> rounds;
+	cout << "- One robot of every how many goes to the next round (Example:4): " << endl;
+	cin >> eta;
+	cout << "All simulations are done with an initial cash of 1000 " << endl;
+
+	ParameterRange range;
+	range.lowest = { min_maPointsS_long, min_maPointsM_long, min_maPointsL_long, min_slopeMin_long, 0, min_maPointsS_short,
+		min_maPointsM_short, min_maPointsL_short, min_slopeMin_short, 0, min_slopePoints, min_stopLoss };
+	range.highest = { max_maPointsS_long, max_maPointsM_long, max_maPointsL_long, max_slopeMin_long, 7, max_maPointsS_short,
+		max_maPointsM_short, max_maPointsL_short, max_slopeMin_short, 7, max_slopePoints, max_stopLoss };
+	SweepRunner::Sampler sampler = [range](mt19937& rng) { return GeneticOptimizer::draw(range, rng); };
+
+	WhiteRobot robot;
+	robot.loadData("/Users/shankar/Desktop/WhiteRobotC/WhiteRobotC/index_data.csv");
+
+	random_device rd;
+	unsigned int seed = rd();
+	cout << "Sweep seed: " << seed << endl;
+
+	SuccessiveHalving halving(robot, ThreadPool::shared());
+	vector<int> best = halving.run(sampler, testNumber, rounds, eta, intialCash, seed,
+		"/Users/shankar/Desktop/WhiteRobotC/WhiteRobotC/simulations.csv");
+
+	if (!best.empty()) {
+		robot.setParameters(halving.getCandidates()[best.front()]);
+		robot.setStatistics(halving.getStatistics()[best.front()]);
+		cout << endl << best.size() << " simulations over all the data added to simulations.csv, the best one:" << endl;
+		robot.writeSimulation(cout);
+	}
+
+	menuPause();
+}
+
+// Time the optimised building blocks against their reference versions
+void RobotMenu::benchmarkWhite() {
+	PriceSeries series;
+	series.load("/Users/shankar/Desktop/WhiteRobotC/WhiteRobotC/index_data.csv");
+	clearConsole();
+	cout << "****************************************************************************" << endl;
+	cout << "			6. Performance benchmarks " << endl;
+	cout << "****************************************************************************" << endl << endl;
+	Benchmark benchmark(series);
+	benchmark.runAll();
+	menuPause();
 }
 
 //Main menu for accessing White Robot program
@@ -513,6 +959,11 @@ void RobotMenu::mainMenu() {
 		cout << "3. Simulate a series of random White Robots with open range" << endl;
 		cout << "4. Series of random White Robots with Closed range" << endl;
 		cout << "5. Random White Robots with Closed range and fixed brain (logic)" << endl;
+		cout << "6. Performance benchmarks" << endl;
+		cout << "7. Single White Robot over a range of stop-loss values" << endl;
+		cout << "8. Walk-forward optimisation of random White Robots" << endl;
+		cout << "9. Evolutionary search of White Robots with Closed range" << endl;
+		cout << "10. Successive halving of random White Robots with Closed range" << endl;
 		cout << "0. To exit the program" << endl;
 		cout << "****************************************************************************" << endl;
 		cout << endl << "Please enter the option number:" << endl;
@@ -532,6 +983,21 @@ void RobotMenu::mainMenu() {
 		else if (option == 5) {
 			FixedBrainRandomWhite();
 		}
+		else if (option == 6) {
+			benchmarkWhite();
+		}
+		else if (option == 7) {
+			stopLossWhite();
+		}
+		else if (option == 8) {
+			walkForwardWhite();
+		}
+		else if (option == 9) {
+			geneticWhite();
+		}
+		else if (option == 10) {
+			halvingWhite();
+		}
 		else if (option == 0) {
 			cout << endl << "Thank you for using the White Robot, have a nice day. " << endl << endl;
 		}
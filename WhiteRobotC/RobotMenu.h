@@ -25,6 +25,12 @@
 #include<stdlib.h>
 #include <random>
 #include "WhiteRobot.h"
+#include "Benchmark.h"
+#include "SweepRunner.h"
+#include "WalkForward.h"
+#include "GeneticOptimizer.h"
+#include "HaltonSampler.h"
+#include "SuccessiveHalving.h"
 using namespace std;
 
 /****************************************************************************************
@@ -40,6 +46,7 @@ public:
 	void clearConsole();
 	void menuPause();
 	void readLine(string& description);
+	SweepRunner::Engine readEngine();
 
 	//public member functions
 	void testData();
@@ -47,6 +54,11 @@ public:
 	void randomWhite();
 	void closedRandomWhite();
 	void FixedBrainRandomWhite();
+	void stopLossWhite();
+	void walkForwardWhite();
+	void geneticWhite();
+	void halvingWhite();
+	void benchmarkWhite();
 	void mainMenu();
 	
 };
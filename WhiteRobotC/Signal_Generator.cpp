@@ -40,4 +40,17 @@ double Signal_Generator::movingSlope(const std::vector<double> prices, int windo
     return slope;
 }
 
-
+// Same sums, in the same order, as the vector version above
+double Signal_Generator::movingSlope(const double* window, int windowSize)
+{
+    double s_x = 0.0, s_y = 0.0, s_xx = 0.0, s_xy = 0.0;
+    for (int i = 0; i < windowSize; i++) {
+        const double x = i;
+        s_x += x;
+        s_y += window[i];
+        s_xx += x * x;
+        s_xy += x * window[i];
+    }
+    const double n = windowSize;
+    return (n * s_xy - s_x * s_y) / (n * s_xx - s_x * s_x);
+}
@@ -15,6 +15,8 @@ public:
     Signal_Generator();
     double movingAverage(std::vector<double> prices, int windowSize);
     double movingSlope(const std::vector<double> prices, int windowSize);
+    // Slope of the windowSize prices starting at window, without copying them
+    double movingSlope(const double* window, int windowSize);
 };
 
 
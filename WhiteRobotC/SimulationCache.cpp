@@ -0,0 +1,141 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	SimulationCache.cpp
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Results of the simulations of a sweep, shared by the parameter sets
+*					that simulate the same way.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+* Other files	:	WhiteStrategy.h defines which averages every mode reacts to.
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*								#INCLUDES AND #CONSTANTS								*
+****************************************************************************************/
+
+#include "SimulationCache.h"
+
+#include <algorithm>
+#include <functional>
+#include <iomanip>
+
+/****************************************************************************************
+*									MEMBER FUNCTIONS									*
+****************************************************************************************/
+
+//public member functions
+
+bool SimulationCache::find(const RobotParameters& p, StrategyStatistics& statistics) {
+	Key key = canonical(p);
+	lock_guard<mutex> lock(m_mutex);
+	++m_lookups;
+	auto it = m_results.find(key);
+	if (it == m_results.end()) {
+		return false;
+	}
+	++m_hits;
+	statistics = it->second;
+	return true;
+}
+
+void SimulationCache::insert(const RobotParameters& p, const StrategyStatistics& statistics) {
+	Key key = canonical(p);
+	lock_guard<mutex> lock(m_mutex);
+	m_results.emplace(key, statistics);
+}
+
+void SimulationCache::clear() {
+	lock_guard<mutex> lock(m_mutex);
+	m_results.clear();
+	m_lookups = 0;
+	m_hits = 0;
+}
+
+void SimulationCache::printHitRate(ostream& out) const {
+	double rate = m_lookups == 0 ? 0 : 100.0 * m_hits / m_lookups;
+	out << "Cached results: " << m_hits << " of " << m_lookups << " simulations (" << fixed << setprecision(1) << rate
+		<< "%), " << m_results.size() << " distinct" << defaultfloat << endl;
+}
+
+
+//private member functions
+
+bool SimulationCache::Key::operator==(const Key& other) const {
+	const RobotParameters& a = parameters;
+	const RobotParameters& b = other.parameters;
+	return start == other.start && a.maPointsS_long == b.maPointsS_long && a.maPointsM_long == b.maPointsM_long &&
+		a.maPointsL_long == b.maPointsL_long && a.slopeMin_long == b.slopeMin_long && a.mode_long == b.mode_long &&
+		a.maPointsS_short == b.maPointsS_short && a.maPointsM_short == b.maPointsM_short &&
+		a.maPointsL_short == b.maPointsL_short && a.slopeMin_short == b.slopeMin_short && a.mode_short == b.mode_short &&
+		a.slopePoints == b.slopePoints && a.stopLoss == b.stopLoss;
+}
+
+size_t SimulationCache::KeyHash::operator()(const Key& key) const {
+	const RobotParameters& p = key.parameters;
+	size_t seed = hash<int>()(key.start);
+	auto combine = [&seed](size_t value) { seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2); };
+	combine(hash<int>()(p.maPointsS_long));
+	combine(hash<int>()(p.maPointsM_long));
+	combine(hash<int>()(p.maPointsL_long));
+	combine(hash<double>()(p.slopeMin_long));
+	combine(hash<int>()(p.mode_long));
+	combine(hash<int>()(p.maPointsS_short));
+	combine(hash<int>()(p.maPointsM_short));
+	combine(hash<int>()(p.maPointsL_short));
+	combine(hash<double>()(p.slopeMin_short));
+	combine(hash<int>()(p.mode_short));
+	combine(hash<int>()(p.slopePoints));
+	combine(hash<double>()(p.stopLoss));
+	return seed;
+}
+
+SimulationCache::Key SimulationCache::canonical(const RobotParameters& p) const {
+	Key key = {};
+	if (p.maPointsS_long <= 1 || p.maPointsM_long <= 1 || p.maPointsL_long <= 1 || p.maPointsS_short <= 1 ||
+		p.maPointsM_short <= 1 || p.maPointsL_short <= 1 || p.slopePoints <= 1) {
+		key.start = -1;
+		return key;
+	}
+
+	// As WhiteStrategy::nextState: mode_long 0 never leaves state 1, and the kernel modes
+	// outside 1 to 7 never open a trade on their side
+	const int mode_long = WhiteStrategy::kernelModeLong(p.mode_long);
+	const int mode_short = WhiteStrategy::kernelModeShort(p.mode_short);
+	const bool trades_long = mode_long >= 1 && mode_long <= 7;
+	const bool trades_short = mode_long != 0 && mode_short != 0;
+	const int start = max({ p.maPointsS_long, p.maPointsM_long, p.maPointsL_long, p.maPointsS_short, p.maPointsM_short,
+		p.maPointsL_short, p.slopePoints });
+	if (!trades_long && !trades_short) {
+		// A pruning rule stops such a robot at a check after its first tradable point
+		key.start = m_pruning ? start : 0;
+		return key;
+	}
+
+	key.start = start;
+	RobotParameters& c = key.parameters;
+	c.mode_long = mode_long;
+	c.slopePoints = p.slopePoints;
+	c.stopLoss = p.stopLoss;
+	// In state 1 a slope over the long minimum stops the short side from entering
+	c.slopeMin_long = p.slopeMin_long;
+
+	// Mode 4 only reacts to the large average, mode 7 only to the medium one
+	if (trades_long) {
+		c.maPointsS_long = p.maPointsS_long;
+		c.maPointsM_long = mode_long != 4 ? p.maPointsM_long : 0;
+		c.maPointsL_long = mode_long != 7 ? p.maPointsL_long : 0;
+	}
+	if (trades_short) {
+		c.mode_short = mode_short;
+		c.slopeMin_short = p.slopeMin_short;
+		c.maPointsS_short = p.maPointsS_short;
+		c.maPointsM_short = mode_short != 4 ? p.maPointsM_short : 0;
+		c.maPointsL_short = mode_short != 7 ? p.maPointsL_short : 0;
+	}
+	return key;
+}
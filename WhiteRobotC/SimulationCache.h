@@ -0,0 +1,97 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	SimulationCache.h
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Results of the simulations of a sweep, shared by the parameter sets
+*					that simulate the same way.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+* Other files	:	WhiteStrategy.h defines which averages every mode reacts to.
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*							#GUARDS #INCLUDES AND #CONSTANTS							*
+****************************************************************************************/
+
+#pragma once
+
+#include <iostream>
+#include <unordered_map>
+#include <mutex>
+#include <cstddef>
+#include "WhiteRobot.h"
+using namespace std;
+
+/****************************************************************************************
+*									CLASS DECLARATION									*
+****************************************************************************************/
+
+// The results are kept by canonical parameters: the windows only count through the first
+// tradable point (the largest window) and the averages the modes react to, and a side that
+// never trades ignores its windows and minimum slope. Every robot that cannot run has the
+// same results, and so has every robot that never trades unless a pruning rule checks the
+// robots: the checks start after the first tradable point. Safe to use from several
+// threads, holds the results of one dataset, initial cash and pruning rule.
+class SimulationCache
+{
+
+public:
+
+	//constructors
+
+	SimulationCache() : m_pruning(false), m_lookups(0), m_hits(0) {}
+
+
+	//Getters
+
+	size_t lookups() const { return m_lookups; }
+
+	size_t hits() const { return m_hits; }
+
+	// Rule of the simulations whose results are cached, call before the first insert
+	void setPruning(const PruningRule& rule) { m_pruning = rule.enabled(); }
+
+
+	//public member functions
+
+	// Results of a parameter set simulating as p into statistics, false if none yet
+	bool find(const RobotParameters& p, StrategyStatistics& statistics);
+
+	void insert(const RobotParameters& p, const StrategyStatistics& statistics);
+
+	// Drops the results and the counters
+	void clear();
+
+	// Share of the lookups answered from the cache
+	void printHitRate(ostream& out) const;
+
+private:
+
+	struct Key {
+		int start; // Largest window, -1 when the robot cannot run and 0 when it never trades (without pruning)
+		RobotParameters parameters; // Fields the simulation does not read set to 0
+
+		bool operator==(const Key& other) const;
+	};
+
+	struct KeyHash {
+		size_t operator()(const Key& key) const;
+	};
+
+	//private member functions
+
+	Key canonical(const RobotParameters& p) const;
+
+	//private variable members
+
+	bool m_pruning; // The simulations are stopped by an enabled PruningRule
+	mutex m_mutex; // Guards the members below
+	unordered_map<Key, StrategyStatistics, KeyHash> m_results; // By canonical parameters
+	size_t m_lookups; // Calls to find since the last clear
+	size_t m_hits; // Calls to find that found results
+};
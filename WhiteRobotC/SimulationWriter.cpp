@@ -0,0 +1,243 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	SimulationWriter.cpp
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Summary rows of the simulations of a sweep, formatted without streams
+*					and written to simulations.csv from a background thread.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+* Other files	:	WhiteRobot.cpp holds the stream version (writeSimulation).
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*								#INCLUDES AND #CONSTANTS								*
+****************************************************************************************/
+
+#include "SimulationWriter.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+	void appendInteger(string& out, long long value) {
+		char digits[24];
+		int count = 0;
+		unsigned long long rest = value < 0 ? 0 - static_cast<unsigned long long>(value) : value;
+		do {
+			digits[count++] = static_cast<char>('0' + rest % 10);
+			rest /= 10;
+		} while (rest != 0);
+		if (value < 0) {
+			out += '-';
+		}
+		while (count > 0) {
+			out += digits[--count];
+		}
+	}
+
+	// value with decimals digits after the point, the bytes of fixed << setprecision(decimals)
+	// (printf "%.*f": the exact binary value rounded to nearest, ties to even)
+	void appendFixed(string& out, double value, int decimals) {
+		const double scale = decimals == 2 ? 100 : 10000;
+		const double magnitude = fabs(value);
+		// Above 2^52 the scaled value has no fraction bits to round
+		if (!(magnitude * scale < 4503599627370496.0)) {
+			char text[512];
+			snprintf(text, sizeof(text), "%.*f", decimals, value);
+			out += text;
+			return;
+		}
+
+		// magnitude * scale is exactly high + low, with low under half a unit of the last place
+		// of high, and high - whole is exact. Only when fraction is one half can low decide.
+		const double high = magnitude * scale;
+		const double low = fma(magnitude, scale, -high);
+		const double whole = floor(high);
+		const double fraction = high - whole;
+		long long units = static_cast<long long>(whole);
+		if (fraction > 0.5 || (fraction == 0.5 && (low > 0 || (low == 0 && units % 2 == 1)))) {
+			++units;
+		}
+
+		long long divisor = decimals == 2 ? 100 : 10000;
+		if (signbit(value)) {
+			out += '-';
+		}
+		appendInteger(out, units / divisor);
+		out += '.';
+		long long rest = units % divisor;
+		for (long long digit = divisor / 10; digit > 0; digit /= 10) {
+			out += static_cast<char>('0' + rest / digit);
+			rest %= digit;
+		}
+	}
+
+	// 100 * (last - first) / first with 2 decimals and a percent sign
+	void appendPercent(string& out, double first, double last) {
+		appendFixed(out, 100 * (last - first) / first, 2);
+		out += '%';
+	}
+}
+
+/****************************************************************************************
+*									MEMBER FUNCTIONS									*
+****************************************************************************************/
+
+const string& SimulationWriter::Clock::now() {
+	time_t second = chrono::system_clock::to_time_t(chrono::system_clock::now());
+	if (second != m_second) {
+		m_second = second;
+		m_time = WhiteRobot::getTimeStr();
+	}
+	return m_time;
+}
+
+
+//constructors
+
+SimulationWriter::SimulationWriter(const string& fileName, shared_ptr<const MarketData> data) :
+	m_data(data), m_writing(false), m_closing(false) {
+	m_file.open(fileName, ios_base::app);
+
+	const MarketData& d = *m_data;
+	if (!d.dates.empty()) {
+		m_dataColumns = Date::formatEpoch(d.dates[0], d.dateFormat) + ",";
+		m_dataColumns += Date::formatEpoch(d.dates.back(), d.dateFormat) + ",";
+		appendFixed(m_dataColumns, d.prices[0], 2);
+		m_dataColumns += ',';
+		appendFixed(m_dataColumns, d.prices.back(), 2);
+		m_dataColumns += ',';
+		appendPercent(m_dataColumns, d.prices[0], d.prices.back());
+		m_dataColumns += ',';
+	}
+
+	m_filling.reserve(kBufferSize + kBufferSize / 4);
+	m_flushing.reserve(kBufferSize + kBufferSize / 4);
+	m_thread = thread(&SimulationWriter::flushLoop, this);
+}
+
+SimulationWriter::~SimulationWriter() {
+	close();
+}
+
+
+//public member functions
+
+void SimulationWriter::formatRow(const RobotParameters& p, const StrategyStatistics& s, const string& time, string& out) const {
+	// Columns of WhiteRobot::writeSimulation
+	out += time;
+	out += ',';
+	out += m_dataColumns;
+
+	appendFixed(out, s.initial_portfolio_value, 2);
+	out += ',';
+	appendFixed(out, s.final_portfolio_value, 2);
+	out += ',';
+	appendPercent(out, s.initial_portfolio_value, s.final_portfolio_value);
+	out += ',';
+
+	appendInteger(out, s.long_trades);
+	out += ',';
+	appendInteger(out, s.good_long_trades);
+	out += ',';
+	appendFixed(out, s.long_trades_profit, 2);
+	out += ',';
+	appendInteger(out, s.long_stop_loss);
+	out += ',';
+
+	appendInteger(out, s.short_trades);
+	out += ',';
+	appendInteger(out, s.good_short_trades);
+	out += ',';
+	appendFixed(out, s.short_trades_profit, 2);
+	out += ',';
+	appendInteger(out, s.short_stop_loss);
+	out += ',';
+
+	appendInteger(out, p.maPointsS_long);
+	out += ',';
+	appendInteger(out, p.maPointsM_long);
+	out += ',';
+	appendInteger(out, p.maPointsL_long);
+	out += ',';
+	appendFixed(out, p.slopeMin_long, 4);
+	out += ',';
+	appendInteger(out, p.mode_long);
+	out += ',';
+
+	appendInteger(out, p.maPointsS_short);
+	out += ',';
+	appendInteger(out, p.maPointsM_short);
+	out += ',';
+	appendInteger(out, p.maPointsL_short);
+	out += ',';
+	appendFixed(out, p.slopeMin_short, 4);
+	out += ',';
+	appendInteger(out, p.mode_short);
+	out += ',';
+
+	appendInteger(out, p.slopePoints);
+	out += ',';
+	appendFixed(out, p.stopLoss, 4);
+	if (s.pruned_point > 0) {
+		out += ",pruned ";
+		out += Date::formatEpoch(m_data->dates[s.pruned_point], m_data->dateFormat);
+	}
+	out += '\n';
+}
+
+void SimulationWriter::write(const string& rows) {
+	unique_lock<mutex> lock(m_mutex);
+	m_filling += rows;
+	if (m_filling.size() >= kBufferSize) {
+		m_changed.wait(lock, [this] { return !m_writing; });
+		m_filling.swap(m_flushing);
+		m_writing = true;
+		m_changed.notify_all();
+	}
+}
+
+void SimulationWriter::close() {
+	{
+		lock_guard<mutex> lock(m_mutex);
+		if (m_closing) {
+			return;
+		}
+		m_closing = true;
+	}
+	m_changed.notify_all();
+	m_thread.join();
+
+	// Rows still queued after the last full buffer
+	m_file.write(m_filling.data(), m_filling.size());
+	m_filling.clear();
+	m_file.close();
+}
+
+
+//private member functions
+
+void SimulationWriter::flushLoop() {
+	unique_lock<mutex> lock(m_mutex);
+	for (;;) {
+		m_changed.wait(lock, [this] { return m_writing || m_closing; });
+		if (!m_writing) {
+			return;
+		}
+
+		// The workers keep filling the other buffer meanwhile
+		lock.unlock();
+		m_file.write(m_flushing.data(), m_flushing.size());
+		lock.lock();
+		m_flushing.clear();
+		m_writing = false;
+		m_changed.notify_all();
+	}
+}
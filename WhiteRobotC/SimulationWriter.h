@@ -0,0 +1,104 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	SimulationWriter.h
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Summary rows of the simulations of a sweep, formatted without streams
+*					and written to simulations.csv from a background thread.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+* Other files	:	WhiteRobot.cpp holds the stream version (writeSimulation).
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*							#GUARDS #INCLUDES AND #CONSTANTS							*
+****************************************************************************************/
+
+#pragma once
+
+#include <fstream>
+#include <string>
+#include <memory>
+#include <ctime>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include "WhiteRobot.h"
+using namespace std;
+
+/****************************************************************************************
+*									CLASS DECLARATION									*
+****************************************************************************************/
+
+// A row is the same bytes WhiteRobot::writeSimulation writes for the robot. The columns of
+// the dataset (dates, index prices and return) are formatted once, numbers are written
+// digit by digit and the simulation date is only read again when the second changes.
+// Queued rows fill a buffer the writer thread writes to the file once full, while the next
+// one fills, so the workers of a sweep do not wait for the disk.
+class SimulationWriter
+{
+
+public:
+
+	// Simulation date of the rows of one thread, WhiteRobot::getTimeStr of the current second
+	class Clock {
+	public:
+		Clock() : m_second(-1) {}
+		const string& now();
+	private:
+		time_t m_second; // Second m_time was read at
+		string m_time; // getTimeStr of m_second
+	};
+
+	//constructors
+
+	// Appends to fileName, rows of simulations on data
+	SimulationWriter(const string& fileName, shared_ptr<const MarketData> data);
+
+	SimulationWriter(const SimulationWriter&) = delete;
+	SimulationWriter& operator=(const SimulationWriter&) = delete;
+
+	~SimulationWriter();
+
+
+	//public member functions
+
+	// Appends the row of a simulation with parameters and statistics to out, at time. Safe
+	// to call from several threads
+	void formatRow(const RobotParameters& parameters, const StrategyStatistics& statistics, const string& time,
+		string& out) const;
+
+	// Queues rows for the file, waits only while both buffers are full
+	void write(const string& rows);
+
+	// Writes every queued row and closes the file
+	void close();
+
+private:
+
+	// Bytes queued before the writer thread takes them
+	static const size_t kBufferSize = 1 << 20;
+
+	//private member functions
+
+	// Body of the writer thread
+	void flushLoop();
+
+	//private variable members
+
+	shared_ptr<const MarketData> m_data; // Dataset of the simulations
+	string m_dataColumns; // Columns 2 to 6 of every row, with their commas
+	ofstream m_file; // simulations.csv
+
+	mutex m_mutex; // Guards the buffers and flags below
+	condition_variable m_changed; // Signals a full buffer, a finished write or closing
+	string m_filling; // Rows queued
+	string m_flushing; // Rows the writer thread is writing
+	bool m_writing; // The writer thread owns m_flushing
+	bool m_closing; // No more rows will be queued
+	thread m_thread; // Writer thread
+};
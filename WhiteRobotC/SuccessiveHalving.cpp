@@ -0,0 +1,150 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	SuccessiveHalving.cpp
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Random White Robots screened on growing prefixes of the data, only the
+*					best ones are simulated on the whole series.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+*					- K. Jamieson, A. Talwalkar: Non-stochastic Best Arm Identification and
+*					  Hyperparameter Optimization. AISTATS 2016.
+* Other files	:	SweepRunner.cpp simulates every robot on the whole series.
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*								#INCLUDES AND #CONSTANTS								*
+****************************************************************************************/
+
+#include "SuccessiveHalving.h"
+
+#include <algorithm>
+#include <iomanip>
+
+/****************************************************************************************
+*									MEMBER FUNCTIONS									*
+****************************************************************************************/
+
+//public member functions
+
+vector<int> SuccessiveHalving::run(const SweepRunner::Sampler& sampler, int testNumber, int rounds, int eta, double intialCash,
+	unsigned int seed, const string& fileName) {
+
+	shared_ptr<const MarketData> data = m_source.getData();
+	const int size = static_cast<int>(data->prices.size());
+	rounds = max(rounds, 1);
+	eta = max(eta, 2);
+
+	m_candidates.clear();
+	for (int i = 0; i < testNumber; i++) {
+		m_candidates.push_back(SweepRunner::draw(sampler, seed, i));
+	}
+
+	// Every round covers the longest warm-up of the candidates, the shares are of the points after it
+	vector<int> survivors(testNumber);
+	int warmUpPoints = 0;
+	for (int i = 0; i < testNumber; i++) {
+		survivors[i] = i;
+		warmUpPoints = max(warmUpPoints, warmUp(m_candidates[i]));
+	}
+	warmUpPoints = min(warmUpPoints, max(size - 1, 0));
+	m_statistics.assign(testNumber, StrategyStatistics());
+	vector<double> score(testNumber);
+	for (int round = 0; round < rounds && size > 0 && !survivors.empty(); ++round) {
+		// Points of the round: the warm-up and (size - warm-up) / eta^(rounds - 1 - round)
+		double share = 1;
+		for (int k = round; k < rounds - 1; ++k) {
+			share /= eta;
+		}
+		const int last = min(size - 1, warmUpPoints + max(1, static_cast<int>((size - warmUpPoints) * share)) - 1);
+
+		// The data up to last as loadSelectedData would slice it, the crossings of the early
+		// rounds are only built for the points they simulate
+		WhiteRobot prefix;
+		if (last < size - 1) {
+			prefix.setData(PriceView{ data->dates.data(), data->prices.data(), static_cast<size_t>(last) + 1, data->dateFormat });
+		}
+		else {
+			prefix.shareData(m_source);
+		}
+		simulate(prefix, survivors, intialCash);
+
+		// A robot only trades after its own warm-up, in the early rounds its return is scaled
+		// from the points it traded to the points it would trade on the whole series. The last
+		// round is ranked by final portfolio value, as a full sweep.
+		for (int i : survivors) {
+			const StrategyStatistics& statistics = m_statistics[i];
+			const int start = warmUp(m_candidates[i]);
+			if (last == size - 1) {
+				score[i] = statistics.final_portfolio_value;
+			}
+			else {
+				double gain = (statistics.final_portfolio_value - statistics.initial_portfolio_value) / statistics.initial_portfolio_value;
+				score[i] = last > start ? gain * (size - 1 - start) / (last - start) : 0;
+			}
+		}
+
+		// Best first, the first drawn on a tie
+		stable_sort(survivors.begin(), survivors.end(), [&score](int a, int b) {
+			return score[a] > score[b];
+		});
+		const StrategyStatistics& best = m_statistics[survivors.front()];
+		cout << "Round " << round << ": " << survivors.size() << " robots up to "
+			<< Date::formatEpoch(data->dates[last], data->dateFormat) << ", best return " << fixed << setprecision(2)
+			<< 100 * (best.final_portfolio_value - best.initial_portfolio_value) / best.initial_portfolio_value << "%"
+			<< defaultfloat << endl;
+		if (round < rounds - 1) {
+			survivors.resize((survivors.size() + eta - 1) / eta);
+		}
+	}
+
+	// Rows of the robots simulated on the whole series, in the order they were drawn
+	if (!fileName.empty()) {
+		vector<int> drawn = survivors;
+		sort(drawn.begin(), drawn.end());
+		SimulationWriter writer(fileName, data);
+		SimulationWriter::Clock clock;
+		string rows;
+		for (int i : drawn) {
+			writer.formatRow(m_candidates[i], m_statistics[i], clock.now(), rows);
+		}
+		writer.write(rows);
+	}
+	return survivors;
+}
+
+
+//private member functions
+
+int SuccessiveHalving::warmUp(const RobotParameters& p) {
+	return max({ p.maPointsS_long, p.maPointsM_long, p.maPointsL_long, p.maPointsS_short, p.maPointsM_short,
+		p.maPointsL_short, p.slopePoints });
+}
+
+void SuccessiveHalving::simulate(const WhiteRobot& prefix, const vector<int>& survivors, double intialCash) {
+	vector<EventBacktester> backtesters;
+	for (int worker = 0; worker < m_scheduler.workers(); ++worker) {
+		backtesters.emplace_back(prefix.getData());
+	}
+	vector<vector<RobotParameters>> batches(m_scheduler.workers());
+
+	const int count = static_cast<int>(survivors.size());
+	m_scheduler.run((count + kBatchSize - 1) / kBatchSize, [&](int worker, int job) {
+		int first = job * kBatchSize;
+		int end = min(first + kBatchSize, count);
+
+		vector<RobotParameters>& batch = batches[worker];
+		batch.clear();
+		for (int k = first; k < end; k++) {
+			batch.push_back(m_candidates[survivors[k]]);
+		}
+		backtesters[worker].run(batch, intialCash);
+		for (int k = first; k < end; k++) {
+			m_statistics[survivors[k]] = backtesters[worker].getStatistics(k - first);
+		}
+	});
+}
@@ -0,0 +1,95 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	SuccessiveHalving.h
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Random White Robots screened on growing prefixes of the data, only the
+*					best ones are simulated on the whole series.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+*					- K. Jamieson, A. Talwalkar: Non-stochastic Best Arm Identification and
+*					  Hyperparameter Optimization. AISTATS 2016.
+* Other files	:	SweepRunner.h simulates every robot on the whole series.
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*							#GUARDS #INCLUDES AND #CONSTANTS							*
+****************************************************************************************/
+
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "WhiteRobot.h"
+#include "EventBacktester.h"
+#include "SweepRunner.h"
+#include "PriceSeries.h"
+#include "SimulationWriter.h"
+#include "ThreadPool.h"
+#include "WorkStealingScheduler.h"
+using namespace std;
+
+/****************************************************************************************
+*									CLASS DECLARATION									*
+****************************************************************************************/
+
+// The candidates are drawn as SweepRunner draws its simulations. Round r of rounds simulates
+// the remaining candidates on the longest warm-up of the candidates plus 1 / eta^(rounds - 1 - r)
+// of the points after it, sliced as WhiteRobot::setData slices a series, and keeps the 1 / eta
+// of them with the best return scaled from the points each robot traded to the whole series.
+// The last round is the whole series, ranked by final portfolio value. Fewer rounds or a
+// smaller eta cost more simulations and keep more of the robots a full sweep ranks best.
+// The robots of a round are simulated in parallel on one dataset shared read-only: the one of
+// the source robot in the last round, a copy of the points of the round in the earlier ones.
+class SuccessiveHalving
+{
+
+public:
+
+	//constructors
+
+	SuccessiveHalving(const WhiteRobot& source, ThreadPool& pool) : m_source(source), m_scheduler(pool) {}
+
+
+	//Getters
+
+	// Candidates of the last run, by index
+	const vector<RobotParameters>& getCandidates() const { return m_candidates; }
+
+	// Results of every candidate in the last round it was simulated
+	const vector<StrategyStatistics>& getStatistics() const { return m_statistics; }
+
+
+	//public member functions
+
+	// Screens testNumber candidates in rounds, appends the summaries of the robots of the
+	// last round to fileName (none if empty) and returns their indices, best first
+	vector<int> run(const SweepRunner::Sampler& sampler, int testNumber, int rounds, int eta, double intialCash,
+		unsigned int seed, const string& fileName);
+
+private:
+
+	// Robots simulated together by one job
+	static const int kBatchSize = 64;
+
+	//private member functions
+
+	// First point the robot can trade at, as EventBacktester starts it
+	static int warmUp(const RobotParameters& p);
+
+	// Simulates the candidates of survivors on the data of prefix, results into m_statistics
+	void simulate(const WhiteRobot& prefix, const vector<int>& survivors, double intialCash);
+
+	//private variable members
+
+	const WhiteRobot& m_source; // Robot holding the loaded data
+	WorkStealingScheduler m_scheduler; // Hands the simulations of a round to the workers
+	vector<RobotParameters> m_candidates; // Candidates of the last run
+	vector<StrategyStatistics> m_statistics; // Results of the candidates, by index
+};
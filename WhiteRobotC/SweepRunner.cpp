@@ -0,0 +1,188 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	SweepRunner.cpp
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Runs a series of random White Robots on the worker threads of a pool.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+*					- A. Williams: C++ Concurrency in Action (Second Edition).
+*					  Manning. 2019. ISBN 978-1617294693.
+* Other files	:
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*								#INCLUDES AND #CONSTANTS								*
+****************************************************************************************/
+
+#include "SweepRunner.h"
+
+#include <algorithm>
+
+/****************************************************************************************
+*									MEMBER FUNCTIONS									*
+****************************************************************************************/
+
+//public member functions
+
+RobotParameters SweepRunner::draw(const Sampler& sampler, unsigned int seed, int index) {
+	seed_seq sequence{ seed, static_cast<unsigned int>(index) };
+	mt19937 rng(sequence);
+	Sampler sample = sampler;
+	return sample(rng);
+}
+
+void SweepRunner::run(const Sampler& sampler, int testNumber, double intialCash, unsigned int seed, const string& fileName) {
+	IndexSampler drawn = [&sampler, seed](int i) { return draw(sampler, seed, i); };
+	run(drawn, testNumber, intialCash, fileName);
+}
+
+void SweepRunner::run(const IndexSampler& sampler, int testNumber, double intialCash, const string& fileName) {
+	m_writer.reset(new SimulationWriter(fileName, m_source.getData()));
+	m_pending.clear();
+	m_next = 0;
+	m_testNumber = testNumber;
+
+	// Only the backtesters of the selected engine are built
+	vector<BatchBacktester> batches;
+	vector<EventBacktester> eventDriven;
+	vector<WhiteRobot> robots;
+	for (int worker = 0; worker < m_scheduler.workers(); ++worker) {
+		if (m_engine == EVENTS) {
+			eventDriven.emplace_back(m_source.getData());
+			eventDriven.back().setPruning(m_pruning);
+		}
+		else if (m_engine == LOCKSTEP) {
+			batches.emplace_back(m_source.getData());
+			batches.back().setPruning(m_pruning);
+		}
+		else {
+			robots.emplace_back();
+			robots.back().shareData(m_source);
+		}
+	}
+
+	// Buffers of every worker, reused by all its jobs
+	struct Buffers {
+		vector<RobotParameters> parameters; // Parameters of the simulations of the job
+		vector<StrategyStatistics> statistics; // Their results
+		vector<RobotParameters> uncached; // Parameters the cache has no results for
+		vector<int> positions; // Position in the job of every uncached simulation
+		string rows; // Rows of the current job
+		SimulationWriter::Clock clock; // Simulation date of the rows
+		int pruned = 0; // Simulations of the worker stopped by the pruning rule
+	};
+	vector<Buffers> buffers(m_scheduler.workers());
+	for (auto& buffer : buffers) {
+		buffer.parameters.reserve(kBatchSize);
+		buffer.statistics.reserve(kBatchSize);
+		buffer.uncached.reserve(kBatchSize);
+		buffer.positions.reserve(kBatchSize);
+	}
+	m_cache.clear();
+	m_cache.setPruning(m_pruning);
+
+	// A job is a batch of consecutive simulations run together through the data
+	int jobs = (testNumber + kBatchSize - 1) / kBatchSize;
+	try {
+		m_scheduler.run(jobs, [&](int worker, int job) {
+			int first = job * kBatchSize;
+			int last = min(first + kBatchSize, testNumber);
+
+			Buffers& buffer = buffers[worker];
+			buffer.parameters.clear();
+			for (int i = first; i < last; i++) {
+				buffer.parameters.push_back(sampler(i));
+			}
+
+			// Only the simulations without cached results go through the engine
+			buffer.statistics.resize(buffer.parameters.size());
+			buffer.uncached.clear();
+			buffer.positions.clear();
+			for (size_t k = 0; k < buffer.parameters.size(); k++) {
+				if (!m_cache.find(buffer.parameters[k], buffer.statistics[k])) {
+					buffer.uncached.push_back(buffer.parameters[k]);
+					buffer.positions.push_back(static_cast<int>(k));
+				}
+			}
+
+			if (m_engine == EVENTS) {
+				eventDriven[worker].run(buffer.uncached, intialCash);
+			}
+			else if (m_engine == LOCKSTEP) {
+				batches[worker].run(buffer.uncached, intialCash);
+			}
+			for (size_t k = 0; k < buffer.uncached.size(); k++) {
+				StrategyStatistics& statistics = buffer.statistics[buffer.positions[k]];
+				if (m_engine == EVENTS) {
+					statistics = eventDriven[worker].getStatistics(k);
+				}
+				else if (m_engine == LOCKSTEP) {
+					statistics = batches[worker].getStatistics(k);
+				}
+				else {
+					// One robot after another, only their statistics are kept
+					robots[worker].setParameters(buffer.uncached[k]);
+					robots[worker].RunStrategySummary(intialCash, m_pruning);
+					statistics = robots[worker].getStatistics();
+				}
+				m_cache.insert(buffer.uncached[k], statistics);
+			}
+
+			buffer.rows.clear();
+			const string& time = buffer.clock.now();
+			for (int i = first; i < last; i++) {
+				m_writer->formatRow(buffer.parameters[i - first], buffer.statistics[i - first], time, buffer.rows);
+				buffer.pruned += buffer.statistics[i - first].pruned_point > 0;
+			}
+			write(job, buffer.rows);
+		});
+	}
+	catch (...) {
+		m_writer.reset();
+		throw;
+	}
+	m_writer.reset();
+	m_scheduler.printUtilization(cout);
+	m_cache.printHitRate(cout);
+	if (m_pruning.enabled()) {
+		int pruned = 0;
+		for (const auto& buffer : buffers) {
+			pruned += buffer.pruned;
+		}
+		cout << "Pruned simulations: " << pruned << " of " << testNumber << endl;
+	}
+}
+
+
+//private member functions
+
+void SweepRunner::write(int job, const string& rows) {
+	lock_guard<mutex> lock(m_mutex);
+	if (job != m_next) {
+		m_pending.emplace(job, rows);
+		return;
+	}
+
+	m_writer->write(rows);
+	for (;;) {
+		int first = m_next * kBatchSize;
+		int last = min(first + kBatchSize, m_testNumber);
+		for (int done = first + 1; done <= last; ++done) {
+			if (done % 100 == 0) {
+				cout << "Simulation number: " << done << endl;
+			}
+		}
+		++m_next;
+		auto it = m_pending.find(m_next);
+		if (it == m_pending.end()) {
+			break;
+		}
+		m_writer->write(it->second);
+		m_pending.erase(it);
+	}
+}
@@ -0,0 +1,113 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	SweepRunner.h
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Runs a series of random White Robots on the worker threads of a pool.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+*					- A. Williams: C++ Concurrency in Action (Second Edition).
+*					  Manning. 2019. ISBN 978-1617294693.
+* Other files	:
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*							#GUARDS #INCLUDES AND #CONSTANTS							*
+****************************************************************************************/
+
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <functional>
+#include "WhiteRobot.h"
+#include "BatchBacktester.h"
+#include "EventBacktester.h"
+#include "SimulationCache.h"
+#include "SimulationWriter.h"
+#include "ThreadPool.h"
+#include "WorkStealingScheduler.h"
+using namespace std;
+
+/****************************************************************************************
+*									CLASS DECLARATION									*
+****************************************************************************************/
+
+// Every worker runs its own backtester of the selected engine (EventBacktester,
+// BatchBacktester bar by bar, or a robot running WhiteRobot::RunStrategySummary) on the
+// dataset of the source robot, which is shared read-only, and takes batches of simulations
+// from a work-stealing scheduler. All of them give the same rows.
+// Simulation i draws its parameters from an engine seeded with (seed, i), or takes them
+// from an IndexSampler, so a sweep gives the same rows whatever the number of threads, and
+// the rows of every batch reach the file in simulation order through a SimulationWriter.
+// Parameter sets that simulate as an earlier one take its results from a SimulationCache
+// instead of running again.
+class SweepRunner
+{
+
+public:
+
+	// Draws the parameters of one simulation, called on a fresh copy for every simulation
+	typedef function<RobotParameters(mt19937&)> Sampler;
+
+	// Parameters of the simulation of an index, called by several workers at once
+	typedef function<RobotParameters(int)> IndexSampler;
+
+	enum Engine { EVENTS, LOCKSTEP, SUMMARY };
+
+	//constructors
+
+	SweepRunner(const WhiteRobot& source, ThreadPool& pool) : m_source(source), m_scheduler(pool), m_engine(EVENTS), m_next(0),
+		m_testNumber(0) {}
+
+
+	//Getters and setters
+
+	void setEngine(Engine engine) { m_engine = engine; }
+
+	// Simulations the rule prunes stop early and their rows are flagged, off by default
+	void setPruning(const PruningRule& rule) { m_pruning = rule; }
+
+
+	//public member functions
+
+	// Parameters of simulation index of a sweep seeded with seed: sampler called on an engine
+	// seeded with (seed, index)
+	static RobotParameters draw(const Sampler& sampler, unsigned int seed, int index);
+
+	// Runs testNumber simulations, appends their summaries to fileName and prints how busy
+	// every worker was, how many results came from the cache and how many were pruned
+	void run(const Sampler& sampler, int testNumber, double intialCash, unsigned int seed, const string& fileName);
+
+	// Same, simulation i taking the parameters of index i
+	void run(const IndexSampler& sampler, int testNumber, double intialCash, const string& fileName);
+
+private:
+
+	// Simulations run together by one job
+	static const int kBatchSize = 64;
+
+	// Writes the rows of job and of any following jobs already done, in simulation order
+	void write(int job, const string& rows);
+
+	const WhiteRobot& m_source; // Robot holding the loaded data
+	WorkStealingScheduler m_scheduler; // Hands the simulations to the workers
+	Engine m_engine; // Backtester of the workers
+	PruningRule m_pruning; // Early stop of the simulations
+	SimulationCache m_cache; // Results of the current sweep
+
+	mutex m_mutex; // Guards the writer state below
+	unique_ptr<SimulationWriter> m_writer; // simulations.csv, during a run
+	map<int, string> m_pending; // Rows of finished jobs waiting for an earlier job
+	int m_next; // Next job to write
+	int m_testNumber; // Simulations of the current run
+};
@@ -0,0 +1,100 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	ThreadPool.h
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Fixed size pool of worker threads fed from a FIFO task queue.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+*					- A. Williams: C++ Concurrency in Action (Second Edition).
+*					  Manning. 2019. ISBN 978-1617294693.
+* Other files	:
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*							#GUARDS #INCLUDES AND #CONSTANTS							*
+****************************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <type_traits>
+
+/****************************************************************************************
+*									CLASS DECLARATION									*
+****************************************************************************************/
+
+class ThreadPool
+{
+
+public:
+
+	//constructors
+
+	// threads == 0 uses one worker per hardware thread
+	explicit ThreadPool(std::size_t threads = 0);
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+
+	//Getters
+
+	std::size_t size() const { return m_workers.size(); }
+
+
+	//public member functions
+
+	// Process wide pool sized to the machine, created on first use
+	static ThreadPool& shared();
+
+	// True on a worker of any pool, where waiting for other tasks of a pool may never return
+	static bool onWorkerThread();
+
+	// Queues a task, the future carries its result or exception
+	template <class Task>
+	std::future<typename std::result_of<Task()>::type> submit(Task task);
+
+	//destructor
+	~ThreadPool();
+
+private:
+
+	void workerLoop();
+
+	std::vector<std::thread> m_workers; // Worker threads
+	std::queue<std::function<void()>> m_tasks; // Pending tasks in submission order
+	std::mutex m_mutex; // Guards m_tasks and m_stop
+	std::condition_variable m_wakeUp; // Signals new tasks or shutdown
+	bool m_stop; // Set by the destructor, workers drain the queue and exit
+};
+
+/****************************************************************************************
+*									TEMPLATE MEMBERS									*
+****************************************************************************************/
+
+template <class Task>
+std::future<typename std::result_of<Task()>::type> ThreadPool::submit(Task task) {
+	typedef typename std::result_of<Task()>::type Result;
+
+	// std::function needs a copyable target, the packaged task is shared instead
+	auto packaged = std::make_shared<std::packaged_task<Result()>>(std::move(task));
+	std::future<Result> result = packaged->get_future();
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_tasks.emplace([packaged]() { (*packaged)(); });
+	}
+	m_wakeUp.notify_one();
+	return result;
+}
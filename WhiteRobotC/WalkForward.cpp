@@ -0,0 +1,157 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	WalkForward.cpp
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Walk-forward optimisation of the White Robot: parameters chosen on a
+*					training period and tested on the period that follows it.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+*					- R. Pardo: The Evaluation and Optimization of Trading Strategies
+*					  (Second Edition). Wiley. 2008. ISBN 978-0470128015.
+* Other files	:	SweepRunner.cpp runs the same searches on the whole series.
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*								#INCLUDES AND #CONSTANTS								*
+****************************************************************************************/
+
+#include "WalkForward.h"
+
+#include <iomanip>
+#include <algorithm>
+
+/****************************************************************************************
+*									MEMBER FUNCTIONS									*
+****************************************************************************************/
+
+//public member functions
+
+void WalkForward::run(const SweepRunner::Sampler& sampler, int testNumber, int trainPoints, int testPoints, double intialCash,
+	unsigned int seed, const string& fileName) {
+
+	shared_ptr<const MarketData> data = m_source.getData();
+	const int size = static_cast<int>(data->prices.size());
+
+	vector<Fold> folds;
+	for (int first = 0; trainPoints > 0 && testPoints > 0 && first + trainPoints + testPoints <= size; first += testPoints) {
+		Fold fold = {};
+		fold.trainFirst = first;
+		fold.trainLast = first + trainPoints - 1;
+		fold.testFirst = first + trainPoints;
+		fold.testLast = first + trainPoints + testPoints - 1;
+		folds.push_back(fold);
+	}
+	if (folds.empty() || testNumber <= 0) {
+		cout << " Not enough data for one fold of " << trainPoints << " training and " << testPoints << " test points" << endl;
+		return;
+	}
+
+	// The same candidates for every fold, drawn as SweepRunner draws its simulations
+	vector<RobotParameters> candidates;
+	for (int i = 0; i < testNumber; i++) {
+		candidates.push_back(SweepRunner::draw(sampler, seed, i));
+	}
+
+	// Final portfolio value of every candidate in the training of every fold
+	vector<double> trainValues(folds.size() * candidates.size());
+	vector<EventBacktester> backtesters;
+	vector<vector<RobotParameters>> batches(m_scheduler.workers());
+	for (int worker = 0; worker < m_scheduler.workers(); ++worker) {
+		backtesters.emplace_back(data);
+	}
+
+	const int batchesPerFold = (testNumber + kBatchSize - 1) / kBatchSize;
+	m_scheduler.run(static_cast<int>(folds.size()) * batchesPerFold, [&](int worker, int job) {
+		const Fold& fold = folds[job / batchesPerFold];
+		int first = job % batchesPerFold * kBatchSize;
+		int last = min(first + kBatchSize, testNumber);
+
+		vector<RobotParameters>& batch = batches[worker];
+		batch.assign(candidates.begin() + first, candidates.begin() + last);
+		backtesters[worker].run(batch, intialCash, fold.trainFirst, fold.trainLast);
+		for (int i = first; i < last; i++) {
+			trainValues[job / batchesPerFold * candidates.size() + i] = backtesters[worker].getStatistics(i - first).final_portfolio_value;
+		}
+	});
+	m_scheduler.printUtilization(cout);
+
+	ofstream file_out(fileName);
+	file_out << "fold,train_start,train_end,test_start,test_end,train_return,test_return,test_final_porfolio,"
+		"test_long_trades,test_good_long_trades,test_long_stop_loss,test_short_trades,test_good_short_trades,test_short_stop_loss,"
+		"small_ma_long,medium_ma_long,large_ma_long,min_slope_long,sm_mode_long,"
+		"small_ma_short,medium_ma_short,large_ma_short,min_slope_short,sm_mode_short,slope_points,stop_loss" << endl;
+
+	// Winners in training (the first one on a tie) and their tests
+	cout << endl;
+	EventBacktester backtester(data);
+	double outOfSample = 1;
+	for (size_t k = 0; k < folds.size(); ++k) {
+		Fold& fold = folds[k];
+		auto values = trainValues.begin() + k * candidates.size();
+		fold.winner = static_cast<int>(max_element(values, values + candidates.size()) - values);
+
+		const vector<RobotParameters> winner(1, candidates[fold.winner]);
+		backtester.run(winner, intialCash, fold.trainFirst, fold.trainLast);
+		fold.train = backtester.getStatistics(0);
+		backtester.run(winner, intialCash, fold.testFirst, fold.testLast);
+		fold.test = backtester.getStatistics(0);
+		outOfSample *= fold.test.final_portfolio_value / fold.test.initial_portfolio_value;
+
+		writeFold(file_out, static_cast<int>(k), fold, candidates[fold.winner]);
+		cout << "Fold " << k << ": candidate " << fold.winner << ", training " << fixed << setprecision(2)
+			<< percent(fold.train) << "%, test " << percent(fold.test) << "% from "
+			<< Date::formatEpoch(data->dates[fold.testFirst], data->dateFormat) << " to "
+			<< Date::formatEpoch(data->dates[fold.testLast], data->dateFormat) << defaultfloat << endl;
+	}
+
+	cout << endl << "Test periods compounded: " << fixed << setprecision(2) << 100 * (outOfSample - 1) << "% over " << folds.size()
+		<< " folds" << defaultfloat << endl;
+	cout << "Walk-forward report written to: " << fileName << endl;
+}
+
+
+//private member functions
+
+double WalkForward::percent(const StrategyStatistics& statistics) {
+	return 100 * (statistics.final_portfolio_value - statistics.initial_portfolio_value) / statistics.initial_portfolio_value;
+}
+
+void WalkForward::writeFold(ostream& out, int index, const Fold& fold, const RobotParameters& p) const {
+	const MarketData& data = *m_source.getData();
+
+	out << index << ",";
+	out << Date::formatEpoch(data.dates[fold.trainFirst], data.dateFormat) << ",";
+	out << Date::formatEpoch(data.dates[fold.trainLast], data.dateFormat) << ",";
+	out << Date::formatEpoch(data.dates[fold.testFirst], data.dateFormat) << ",";
+	out << Date::formatEpoch(data.dates[fold.testLast], data.dateFormat) << ",";
+	out << fixed << setprecision(2) << percent(fold.train) << "%" << ",";
+	out << fixed << setprecision(2) << percent(fold.test) << "%" << ",";
+	out << fixed << setprecision(2) << fold.test.final_portfolio_value << ",";
+
+	out << fold.test.long_trades << ",";
+	out << fold.test.good_long_trades << ",";
+	out << fold.test.long_stop_loss << ",";
+	out << fold.test.short_trades << ",";
+	out << fold.test.good_short_trades << ",";
+	out << fold.test.short_stop_loss << ",";
+
+	out << p.maPointsS_long << ",";
+	out << p.maPointsM_long << ",";
+	out << p.maPointsL_long << ",";
+	out << fixed << setprecision(4) << p.slopeMin_long << ",";
+	out << p.mode_long << ",";
+
+	out << p.maPointsS_short << ",";
+	out << p.maPointsM_short << ",";
+	out << p.maPointsL_short << ",";
+	out << fixed << setprecision(4) << p.slopeMin_short << ",";
+	out << p.mode_short << ",";
+
+	out << p.slopePoints << ",";
+	out << fixed << setprecision(4) << p.stopLoss << defaultfloat << endl;
+}
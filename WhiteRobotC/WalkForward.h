@@ -0,0 +1,92 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	WalkForward.h
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Walk-forward optimisation of the White Robot: parameters chosen on a
+*					training period and tested on the period that follows it.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+*					- R. Pardo: The Evaluation and Optimization of Trading Strategies
+*					  (Second Edition). Wiley. 2008. ISBN 978-0470128015.
+* Other files	:	SweepRunner.h runs the same searches on the whole series.
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*							#GUARDS #INCLUDES AND #CONSTANTS							*
+****************************************************************************************/
+
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "WhiteRobot.h"
+#include "EventBacktester.h"
+#include "SweepRunner.h"
+#include "ThreadPool.h"
+#include "WorkStealingScheduler.h"
+using namespace std;
+
+/****************************************************************************************
+*									CLASS DECLARATION									*
+****************************************************************************************/
+
+// The loaded series is split in rolling folds: trainPoints points of training followed by
+// testPoints points of test, every fold starting testPoints after the previous one, so the
+// tests follow each other. Every fold simulates the same candidate parameter sets on its
+// training points, the one with the highest final portfolio value wins and is simulated
+// on the test points. A simulation only trades inside its period, the points before it are
+// history for the indicators. The training of all the folds runs as one set of jobs on the
+// scheduler, and every fold reads the dataset of the source robot, with its indicator table
+// and its crossings, shared read-only.
+class WalkForward
+{
+
+public:
+
+	//constructors
+
+	WalkForward(const WhiteRobot& source, ThreadPool& pool) : m_source(source), m_scheduler(pool) {}
+
+
+	//public member functions
+
+	// Draws testNumber candidates as SweepRunner::run does, runs the folds, writes one row
+	// per fold to fileName and prints them
+	void run(const SweepRunner::Sampler& sampler, int testNumber, int trainPoints, int testPoints, double intialCash,
+		unsigned int seed, const string& fileName);
+
+private:
+
+	// Candidates simulated together by one job
+	static const int kBatchSize = 64;
+
+	struct Fold {
+		int trainFirst; // First training point
+		int trainLast; // Last training point
+		int testFirst; // First test point
+		int testLast; // Last test point
+		int winner; // Candidate with the highest final portfolio value in training
+		StrategyStatistics train; // Results of the winner in training
+		StrategyStatistics test; // Results of the winner in test
+	};
+
+	//private member functions
+
+	// Return of a simulation in percent
+	static double percent(const StrategyStatistics& statistics);
+
+	// One row of the report
+	void writeFold(ostream& out, int index, const Fold& fold, const RobotParameters& p) const;
+
+	//private variable members
+
+	const WhiteRobot& m_source; // Robot holding the loaded data
+	WorkStealingScheduler m_scheduler; // Hands the training jobs to the workers
+};
@@ -20,6 +20,13 @@
 ****************************************************************************************/
 
 #include "WhiteRobot.h"
+#include "ThreadPool.h"
+
+#include <future>
+#include <exception>
+
+// Fewer points than this per chunk are not worth a task switch
+static const int kMinChunkPoints = 16 * 1024;
 /****************************************************************************************
 *									MEMBER FUNCTIONS									*
 ****************************************************************************************/
@@ -31,12 +38,42 @@
 //Getters and setters
 
 vector<double> WhiteRobot::getPrices() {
-    return this->m_prices;
+    return m_data->prices;
+}
+
+StrategyStatistics WhiteRobot::getStatistics() const {
+	StrategyStatistics statistics;
+	statistics.initial_portfolio_value = m_initial_portfolio_value;
+	statistics.final_portfolio_value = m_final_portfolio_value;
+	statistics.long_trades = m_long_trades;
+	statistics.good_long_trades = m_good_long_trades;
+	statistics.long_trades_profit = m_long_trades_profit;
+	statistics.long_stop_loss = m_long_stop_loss;
+	statistics.short_trades = m_short_trades;
+	statistics.good_short_trades = m_good_short_trades;
+	statistics.short_trades_profit = m_short_trades_profit;
+	statistics.short_stop_loss = m_short_stop_loss;
+	statistics.pruned_point = m_pruned_point;
+	return statistics;
+}
+
+void WhiteRobot::setStatistics(const StrategyStatistics& statistics) {
+	m_initial_portfolio_value = statistics.initial_portfolio_value;
+	m_final_portfolio_value = statistics.final_portfolio_value;
+	m_long_trades = statistics.long_trades;
+	m_good_long_trades = statistics.good_long_trades;
+	m_long_trades_profit = statistics.long_trades_profit;
+	m_long_stop_loss = statistics.long_stop_loss;
+	m_short_trades = statistics.short_trades;
+	m_good_short_trades = statistics.good_short_trades;
+	m_short_trades_profit = statistics.short_trades_profit;
+	m_short_stop_loss = statistics.short_stop_loss;
+	m_pruned_point = statistics.pruned_point;
 }
 
 void WhiteRobot::printPrices() {
     cout << "Printing Data" << endl;
-    for (auto& element : m_prices) {
+    for (auto& element : m_data->prices) {
         cout << element << endl;
     }
 }
@@ -69,6 +106,7 @@ void WhiteRobot::setParameters(int maPointsS_long, int maPointsM_long, int maPoi
 	m_good_short_trades = 0;
 	m_long_trades_profit = 0;
 	m_short_trades_profit = 0;
+	m_pruned_point = 0;
 
 	m_ma_small_long.clear();
 	m_ma_medium_long.clear();
@@ -91,11 +129,19 @@ void WhiteRobot::setParameters(int maPointsS_long, int maPointsM_long, int maPoi
 	m_stop_loss.clear();
 }
 
+void WhiteRobot::setParameters(const RobotParameters& p) {
+	setParameters(p.maPointsS_long, p.maPointsM_long, p.maPointsL_long, p.slopeMin_long, p.mode_long, p.maPointsS_short, p.maPointsM_short,
+		p.maPointsL_short, p.slopeMin_short, p.mode_short, p.slopePoints, p.stopLoss);
+}
+
 
 string WhiteRobot::getTimeStr() {
 	std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
 
 	std::string s(30, '\0');
+	// std::localtime shares one buffer, robots of a sweep run in several threads
+	static std::mutex time_mutex;
+	std::lock_guard<std::mutex> lock(time_mutex);
 	std::strftime(&s[0], s.size(), "%Y-%m-%d %H:%M:%S", std::localtime(&now));
 	return s;
 }
@@ -120,114 +166,215 @@ vector<string> WhiteRobot::tokenize(string& str, char delim) {
 
 // Load the index data from CSV file
 void WhiteRobot::loadData(string fileName) {
-	string line;
-	ifstream myStream(fileName);
-	if (myStream.is_open()) {
-		cout << endl <<" " << fileName << " successfully opened." << line << endl;
-		getline(myStream, line);
-		cout << "The first line is: " << line << endl;
+	PriceSeries series;
+	if (series.load(fileName)) {
+		appendData(series.all());
+	}
+}
 
+//Load Data based on Time Constraints, bars with from <= date < to ("N/A" leaves a side open)
+void WhiteRobot:: loadSelectedData(string fileName, string from, string to) {
+	long long first = numeric_limits<long long>::min();
+	long long last = numeric_limits<long long>::max();
+	if (from != "N/A" && !Date::parseUserDate(from, first)) {
+		cout << "Invalid starting date: " << from << endl;
+		return;
+	}
+	if (to != "N/A" && !Date::parseUserDate(to, last)) {
+		cout << "Invalid end date: " << to << endl;
+		return;
+	}
 
-		while (getline(myStream, line)) {
+	PriceSeries series;
+	if (series.load(fileName)) {
+		appendData(series.slice(first, last));
+	}
+}
 
-			//Parses the line
-			vector<string> fields = tokenize(line, ',');
-			double price = stod(fields[1]);
+// Replace the robot data with a window of an already loaded series
+void WhiteRobot::setData(const PriceView& view) {
+	m_data = make_shared<MarketData>();
+	appendData(view);
+}
 
-			// Stores the read values
-			if (price > 0) {
-				m_dates.push_back(fields[0]);
-				m_prices.push_back(price);
-			}
-		}
-		myStream.close();
-	}
-	else
-	{
-		cout << "There was a problem opening the file: " << fileName << endl;
-	}
+// Use the dataset of another robot, the data is shared and never modified
+void WhiteRobot::shareData(const WhiteRobot& source) {
+	m_data = source.m_data;
 }
 
-//Load Data based on Time Constraints
-void WhiteRobot:: loadSelectedData(string fileName, string from, string to) {
-    string line;
-
-    ifstream myStream(fileName);
-    if (myStream.is_open()) {
-        cout << endl << " " << fileName << " successfully opened." << line << endl;
-        getline(myStream, line);
-        cout << "The first line is: " << line << endl;
-
-
-        while (getline(myStream, line)) {
-
-            //Parses the line
-            vector<string> fields = tokenize(line, ',');
-            Date d(fields[0]);
-            string time = (d.reformat_date());
-            double price = stod(fields[1]);
-            if (time == to)
-            {
-                break;
-            }
-            else if (time >= from) {
-                // Stores the read values
-                if (price > 0) {
-                    m_dates.push_back(fields[0]);
-                    m_prices.push_back(price);
-                }
-            }
+// Robots may share m_data, so appending builds a new dataset
+void WhiteRobot::appendData(const PriceView& view) {
+	shared_ptr<MarketData> data = make_shared<MarketData>();
+	data->dates = m_data->dates;
+	data->dates.insert(data->dates.end(), view.times, view.times + view.size);
+	data->dateFormat = view.dateFormat;
+	data->prices = m_data->prices;
+	data->prices.insert(data->prices.end(), view.prices, view.prices + view.size);
+	data->indicators.build(data->prices);
+	data->events.build(data->prices, data->indicators);
+	m_data = data;
+}
 
-        }
-        myStream.close();
-    } else {
-        cout << "There was a problem opening the file: " << fileName << endl;
-    }
+
+
+// Indicators of the window ending at point
+void WhiteRobot::readSignals(int point, double& slope, MovingAverages& ma_long, MovingAverages& ma_short) {
+
+	ma_long.small = m_data->indicators.average(point, m_maPointsS_long);
+	ma_long.medium = m_data->indicators.average(point, m_maPointsM_long);
+	ma_long.large = m_data->indicators.average(point, m_maPointsL_long);
+
+	ma_short.small = m_data->indicators.average(point, m_maPointsS_short);
+	ma_short.medium = m_data->indicators.average(point, m_maPointsM_short);
+	ma_short.large = m_data->indicators.average(point, m_maPointsL_short);
+
+	slope = m_data->indicators.slope(point, m_slopePoints);
+	settleSignals(point, slope, ma_long, ma_short);
 }
 
+// Exact values where the state machine compares nearly equal averages, or the slope to its minimums
+void WhiteRobot::settleSignals(int point, double& slope, MovingAverages& ma_long, MovingAverages& ma_short) {
+	m_data->indicators.settleTie(point, m_maPointsS_long, ma_long.small, m_maPointsM_long, ma_long.medium);
+	m_data->indicators.settleTie(point, m_maPointsS_long, ma_long.small, m_maPointsL_long, ma_long.large);
+	m_data->indicators.settleTie(point, m_maPointsS_short, ma_short.small, m_maPointsM_short, ma_short.medium);
+	m_data->indicators.settleTie(point, m_maPointsS_short, ma_short.small, m_maPointsL_short, ma_short.large);
 
+	m_data->indicators.settleThreshold(point, m_slopePoints, slope, m_slopeMin_long);
+	m_data->indicators.settleThreshold(point, m_slopePoints, slope, -m_slopeMin_short);
+}
 
-// Signal generator function
-void WhiteRobot::generateSignals(vector<double> prices_window) {
+// Signal generator function, indicators of every point from m_point to the end of the data
+// (zero before m_point). The points do not depend on each other, long series are split in
+// chunks computed on pool.
+void WhiteRobot::generateSignals(ThreadPool* pool) {
+	const int first = m_point;
+	const int size = static_cast<int>(m_data->prices.size());
+
+	m_ma_small_long.resize(size, 0);
+	m_ma_medium_long.resize(size, 0);
+	m_ma_large_long.resize(size, 0);
+
+	m_ma_small_short.resize(size, 0);
+	m_ma_medium_short.resize(size, 0);
+	m_ma_large_short.resize(size, 0);
+
+	m_slope.resize(size, 0);
+
+	// Same values as readSignals, the averages of a chunk in one pass per window
+	auto fill = [this](int from, int to) {
+		const IndicatorTable& indicators = m_data->indicators;
+		indicators.averages(from, to - 1, m_maPointsS_long, &m_ma_small_long[from]);
+		indicators.averages(from, to - 1, m_maPointsM_long, &m_ma_medium_long[from]);
+		indicators.averages(from, to - 1, m_maPointsL_long, &m_ma_large_long[from]);
+
+		indicators.averages(from, to - 1, m_maPointsS_short, &m_ma_small_short[from]);
+		indicators.averages(from, to - 1, m_maPointsM_short, &m_ma_medium_short[from]);
+		indicators.averages(from, to - 1, m_maPointsL_short, &m_ma_large_short[from]);
+
+		for (int point = from; point < to; ++point) {
+			double slope = indicators.slope(point, m_slopePoints);
+			MovingAverages ma_long = { m_ma_small_long[point], m_ma_medium_long[point], m_ma_large_long[point] };
+			MovingAverages ma_short = { m_ma_small_short[point], m_ma_medium_short[point], m_ma_large_short[point] };
+			settleSignals(point, slope, ma_long, ma_short);
+
+			m_ma_small_long[point] = ma_long.small;
+			m_ma_medium_long[point] = ma_long.medium;
+			m_ma_large_long[point] = ma_long.large;
+
+			m_ma_small_short[point] = ma_short.small;
+			m_ma_medium_short[point] = ma_short.medium;
+			m_ma_large_short[point] = ma_short.large;
+
+			m_slope[point] = slope;
+		}
+	};
 
+	if (first >= size) {
+		return;
+	}
+	const int points = size - first;
+	const int chunks = pool == nullptr ? 1 : static_cast<int>(min<size_t>(pool->size(), points / kMinChunkPoints + 1));
+	if (chunks <= 1) {
+		fill(first, size);
+		return;
+	}
 
-	m_ma_small_long.push_back(generate.movingAverage(prices_window, m_maPointsS_long));
-	m_ma_medium_long.push_back(generate.movingAverage(prices_window, m_maPointsM_long));
-	m_ma_large_long.push_back(generate.movingAverage(prices_window, m_maPointsL_long));
+	// The chunks write into the signal vectors through fill, so every submitted one finishes before a failure is rethrown
+	vector<future<void>> done;
+	done.reserve(chunks);
+	exception_ptr failure;
+	try {
+		for (int k = 0; k < chunks; ++k) {
+			int from = first + static_cast<int>(static_cast<long long>(points) * k / chunks);
+			int to = first + static_cast<int>(static_cast<long long>(points) * (k + 1) / chunks);
+			done.push_back(pool->submit([&fill, from, to]() { fill(from, to); }));
+		}
+	}
+	catch (...) {
+		failure = current_exception();
+	}
+	for (auto& chunk : done) {
+		try {
+			chunk.get();
+		}
+		catch (...) {
+			if (!failure) {
+				failure = current_exception();
+			}
+		}
+	}
+	if (failure) {
+		rethrow_exception(failure);
+	}
+}
 
-	m_ma_small_short.push_back(generate.movingAverage(prices_window, m_maPointsS_short));
-	m_ma_medium_short.push_back(generate.movingAverage(prices_window, m_maPointsM_short));
-	m_ma_large_short.push_back(generate.movingAverage(prices_window, m_maPointsL_short));
 
-	m_slope.push_back(generate.movingSlope(prices_window, m_slopePoints));
+// setParameters only clears the per point vectors, once they hold a point per price a
+// robot runs any number of simulations on the dataset without allocating
+void WhiteRobot::reserveBuffers() {
+	const size_t size = m_data->prices.size();
+
+	m_ma_small_long.reserve(size);
+	m_ma_medium_long.reserve(size);
+	m_ma_large_long.reserve(size);
+
+	m_ma_small_short.reserve(size);
+	m_ma_medium_short.reserve(size);
+	m_ma_large_short.reserve(size);
+
+	m_slope.reserve(size);
+	m_state_signal.reserve(size);
+	m_order_signal.reserve(size);
+
+	m_current_cash.reserve(size);
+	m_cfd_units.reserve(size);
+	m_last_trade_investment.reserve(size);
+	m_portfolio_value.reserve(size);
+	m_trade_profit.reserve(size);
+	m_stop_loss.reserve(size);
 }
 
+// White strategy backtest implementation. A pool worker waiting for chunks queued behind
+// other waiting workers would never wake up, there the indicators are computed inline
+void WhiteRobot::RunStrategy(double intialCash) {
+    RunStrategy(intialCash, ThreadPool::onWorkerThread() ? nullptr : &ThreadPool::shared());
+}
 
-// White strategy backtest implementation
-void WhiteRobot::RunStrategy( double intialCash) {
+void WhiteRobot::RunStrategy(double intialCash, ThreadPool* pool) {
     //cout << "Executing White strategy" << endl;
 
     double current_cash = intialCash;
     double last_trade_investment = 1;
     double cfd_units = 0;
-    vector<int> max_vect{m_maPointsS_long, m_maPointsM_long, m_maPointsL_long, m_maPointsS_short, m_maPointsM_short,
-                         m_maPointsL_short, m_slopePoints};
-    int max_window_size = *max_element(max_vect.begin(), max_vect.end());
+    m_initial_portfolio_value = intialCash;
+    int max_window_size = max({m_maPointsS_long, m_maPointsM_long, m_maPointsL_long, m_maPointsS_short, m_maPointsM_short,
+                               m_maPointsL_short, m_slopePoints});
+    reserveBuffers();
 
     if (m_maPointsS_long > 1 && m_maPointsM_long > 1 && m_maPointsL_long > 1 && m_maPointsS_short > 1 &&
         m_maPointsM_short > 1 && m_maPointsL_short > 1 && m_slopePoints > 1) {
 
         //Resizes the vectors for dataset entry
-        m_ma_small_long.resize(max_window_size, 0);
-        m_ma_medium_long.resize(max_window_size,0);
-        m_ma_large_long.resize(max_window_size,0);
-
-        m_ma_small_short.resize(max_window_size,0);
-        m_ma_medium_short.resize(max_window_size,0);
-        m_ma_large_short.resize(max_window_size,0);
-
-        m_slope.resize(max_window_size,0);
-
         m_state_signal.resize(max_window_size,0);
         m_order_signal.resize(max_window_size,0);
 
@@ -240,21 +387,20 @@ void WhiteRobot::RunStrategy( double intialCash) {
         m_stop_loss.resize(max_window_size,0);
         m_point = max_window_size;
 
+        // The indicators of the whole dataset first, the state machine then only reads them
+        generateSignals(pool);
+        const WhiteStrategy::StateKernel kernel = WhiteStrategy::stateKernel(m_mode_long, m_mode_short);
+
         // Loop over the tradable part of the dataset
-        for (auto it = m_prices.begin() + max_window_size; it != m_prices.end(); ++it) {
-            vector<double> prices_window;
-            prices_window = vector<double>(it - max_window_size + 1, it + 1);
-            generateSignals(prices_window);
-            if(m_point==403)
-            {std::cout<<"caught";}
+        for (auto it = m_data->prices.begin() + max_window_size; it < m_data->prices.end(); ++it) {
             m_order_signal.push_back(ws.whiteStateMachine(last_trade_investment, m_state, m_slope, m_point, m_slopeMin_long,
-                                                          m_mode_long, m_ma_small_long, m_ma_medium_long, m_ma_large_long,
+                                                          m_ma_small_long, m_ma_medium_long, m_ma_large_long,
                                                           m_slopeMin_short, m_ma_small_short, m_ma_medium_short,
-                                                          m_ma_large_short, m_mode_short, m_state_signal, m_portfolio_value, m_stop_loss,
-                                                          m_long_stop_loss, m_stopLoss, m_short_stop_loss, m_prices));
+                                                          m_ma_large_short, m_state_signal, m_portfolio_value, m_stop_loss,
+                                                          m_long_stop_loss, m_stopLoss, m_short_stop_loss, m_data->prices, kernel));
 
             m_portfolio_value.push_back(ws.orderAnalyser(current_cash, last_trade_investment, cfd_units, m_order_signal,
-                     m_point, m_prices, m_long_trades, m_short_trades, m_long_trades_profit,
+                     m_point, m_data->prices, m_long_trades, m_short_trades, m_long_trades_profit,
                      m_trade_profit, m_good_long_trades, m_short_trades_profit, m_good_short_trades,
                      m_current_cash, m_cfd_units, m_last_trade_investment));
             ++m_point;
@@ -264,7 +410,7 @@ void WhiteRobot::RunStrategy( double intialCash) {
         cout << " Strategy Impossible to execute" << endl;
 
         // Fill everythong with 0 to avoid memory acces errors
-        for (auto it = m_prices.begin(); it != m_prices.end(); ++it) {
+        for (auto it = m_data->prices.begin(); it != m_data->prices.end(); ++it) {
 
             m_ma_small_long.push_back(0.0);
             m_ma_medium_long.push_back(0.0);
@@ -290,10 +436,182 @@ void WhiteRobot::RunStrategy( double intialCash) {
             ++m_point;
         }
     }
+
+    m_final_portfolio_value = m_portfolio_value.empty() ? intialCash : m_portfolio_value.back();
 }
 
 
 
+// White strategy backtest for parameter sweeps: only the scalar state of the robot and the
+// statistics are kept, the trades are the same as RunStrategy
+void WhiteRobot::RunStrategySummary(double intialCash) {
+	RunStrategySummary(intialCash, PruningRule());
+}
+
+// The checks are at the multiples of checkpointPoints after the first tradable point and
+// before the last one, on the portfolio value of the point
+void WhiteRobot::RunStrategySummary(double intialCash, const PruningRule& pruning) {
+
+	double current_cash = intialCash;
+	double last_trade_investment = 1;
+	double cfd_units = 0;
+	double portfolio_value = intialCash;
+	double trade_profit = 0;
+	m_initial_portfolio_value = intialCash;
+	m_final_portfolio_value = intialCash;
+
+	if (m_maPointsS_long <= 1 || m_maPointsM_long <= 1 || m_maPointsL_long <= 1 || m_maPointsS_short <= 1 ||
+		m_maPointsM_short <= 1 || m_maPointsL_short <= 1 || m_slopePoints <= 1) {
+		cout << " Strategy Impossible to execute" << endl;
+		return;
+	}
+
+	int max_window_size = max({ m_maPointsS_long, m_maPointsM_long, m_maPointsL_long, m_maPointsS_short, m_maPointsM_short,
+		m_maPointsL_short, m_slopePoints });
+	const int size = static_cast<int>(m_data->prices.size());
+
+	// RunStrategy pads the histories with zeros before the first tradable point
+	MovingAverages previous_long = { 0, 0, 0 };
+	MovingAverages previous_short = { 0, 0, 0 };
+	int previous_order = 0;
+	double peak = intialCash;
+	const WhiteStrategy::StateKernel kernel = WhiteStrategy::stateKernel(m_mode_long, m_mode_short);
+
+	for (m_point = max_window_size; m_point < size; ++m_point) {
+		double slope;
+		MovingAverages ma_long, ma_short;
+		readSignals(m_point, slope, ma_long, ma_short);
+
+		if (ws.stopLossReached(last_trade_investment, portfolio_value, m_state, m_long_stop_loss, m_stopLoss, m_short_stop_loss, m_point == size - 1)) {
+			// Slop loss limit reached in the previous point
+			m_state = 1;
+		}
+		else {
+			m_state = kernel(m_state, slope, ma_long, previous_long, ma_short, previous_short, m_slopeMin_long, m_slopeMin_short);
+		}
+
+		int order = ws.stateAnalyser(m_state);
+		portfolio_value = ws.executeOrder(order, previous_order, m_data->prices[m_point], current_cash, last_trade_investment, cfd_units,
+			m_long_trades, m_short_trades, m_long_trades_profit, m_good_long_trades, m_short_trades_profit, m_good_short_trades, trade_profit);
+
+		previous_order = order;
+		previous_long = ma_long;
+		previous_short = ma_short;
+
+		if (pruning.enabled() && m_point % pruning.checkpointPoints == 0 && m_point > max_window_size && m_point < size - 1 &&
+			pruning.prunes(portfolio_value, peak)) {
+			m_pruned_point = m_point;
+			break;
+		}
+	}
+
+	m_final_portfolio_value = portfolio_value;
+}
+
+// RunStrategySummary for every stop loss of stopLosses in one pass, the statistics in the
+// same order. The simulations only differ once a stop loss triggers for some of them and not
+// for others: they run as lanes sharing a range of the sorted stop losses, a lane splits in
+// two at the point where its stop losses disagree. The robot keeps its own statistics.
+vector<StrategyStatistics> WhiteRobot::RunStrategyStopLosses(double intialCash, const vector<double>& stopLosses) {
+
+	StrategyStatistics initial = {};
+	initial.initial_portfolio_value = intialCash;
+	initial.final_portfolio_value = intialCash;
+	vector<StrategyStatistics> results(stopLosses.size(), initial);
+
+	if (m_maPointsS_long <= 1 || m_maPointsM_long <= 1 || m_maPointsL_long <= 1 || m_maPointsS_short <= 1 ||
+		m_maPointsM_short <= 1 || m_maPointsL_short <= 1 || m_slopePoints <= 1) {
+		cout << " Strategy Impossible to execute" << endl;
+		return results;
+	}
+	if (stopLosses.empty()) {
+		return results;
+	}
+
+	int max_window_size = max({ m_maPointsS_long, m_maPointsM_long, m_maPointsL_long, m_maPointsS_short, m_maPointsM_short,
+		m_maPointsL_short, m_slopePoints });
+	const int size = static_cast<int>(m_data->prices.size());
+
+	// A trade reaches every stop loss under its loss, in increasing order they are a prefix of the lane
+	vector<int> positions(stopLosses.size());
+	iota(positions.begin(), positions.end(), 0);
+	stable_sort(positions.begin(), positions.end(), [&stopLosses](int a, int b) { return stopLosses[a] < stopLosses[b]; });
+	vector<double> sorted;
+	for (int position : positions) {
+		sorted.push_back(stopLosses[position]);
+	}
+
+	struct Lane {
+		int first; // First stop loss of the lane in sorted
+		int last; // One past its last stop loss
+		int state;
+		int order;
+		double current_cash;
+		double last_trade_investment;
+		double cfd_units;
+		double portfolio_value;
+		StrategyStatistics statistics;
+	};
+	vector<Lane> lanes;
+	lanes.push_back({ 0, static_cast<int>(sorted.size()), 1, 0, intialCash, 1, 0, intialCash, initial });
+
+	// RunStrategy pads the histories with zeros before the first tradable point
+	MovingAverages previous_long = { 0, 0, 0 };
+	MovingAverages previous_short = { 0, 0, 0 };
+
+	for (int point = max_window_size; point < size; ++point) {
+		double slope;
+		MovingAverages ma_long, ma_short;
+		readSignals(point, slope, ma_long, ma_short);
+		const bool last_point = point == size - 1;
+
+		// Lanes split in the loop are stepped at the end of it
+		for (size_t l = 0; l < lanes.size(); ++l) {
+			int counted = 0;
+			auto reached = [&](double stopLoss) {
+				return ws.stopLossReached(lanes[l].last_trade_investment, lanes[l].portfolio_value, lanes[l].state, counted, stopLoss,
+					counted, false);
+			};
+			int split = static_cast<int>(partition_point(sorted.begin() + lanes[l].first, sorted.begin() + lanes[l].last, reached) - sorted.begin());
+			if (split > lanes[l].first && split < lanes[l].last) {
+				Lane rest = lanes[l];
+				rest.first = split;
+				lanes[l].last = split;
+				lanes.push_back(rest);
+			}
+
+			Lane& lane = lanes[l];
+			if (ws.stopLossReached(lane.last_trade_investment, lane.portfolio_value, lane.state, lane.statistics.long_stop_loss,
+				sorted[lane.first], lane.statistics.short_stop_loss, last_point)) {
+				// Slop loss limit reached in the previous point
+				lane.state = 1;
+			}
+			else {
+				lane.state = ws.nextState(lane.state, slope, ma_long, previous_long, ma_short, previous_short, m_slopeMin_long, m_mode_long,
+					m_slopeMin_short, m_mode_short);
+			}
+
+			int order = ws.stateAnalyser(lane.state);
+			double trade_profit;
+			lane.portfolio_value = ws.executeOrder(order, lane.order, m_data->prices[point], lane.current_cash, lane.last_trade_investment,
+				lane.cfd_units, lane.statistics.long_trades, lane.statistics.short_trades, lane.statistics.long_trades_profit,
+				lane.statistics.good_long_trades, lane.statistics.short_trades_profit, lane.statistics.good_short_trades, trade_profit);
+			lane.order = order;
+		}
+
+		previous_long = ma_long;
+		previous_short = ma_short;
+	}
+
+	for (Lane& lane : lanes) {
+		lane.statistics.final_portfolio_value = lane.portfolio_value;
+		for (int k = lane.first; k < lane.last; ++k) {
+			results[positions[k]] = lane.statistics;
+		}
+	}
+	return results;
+}
+
 // Print backtest simulation results on the console
 void WhiteRobot::printResults() {
 
@@ -302,16 +620,20 @@ void WhiteRobot::printResults() {
 
 	cout << "Simulation date: " << getTimeStr() << endl << endl;
 
-	cout << "Initial date: " << m_dates[0] << endl ;
-	cout << "Final date: " << m_dates.back() << endl << endl;
+	if (m_data->dates.empty()) {
+		cout << "No data loaded, nothing was simulated." << endl;
+		return;
+	}
+	cout << "Initial date: " << Date::formatEpoch(m_data->dates[0], m_data->dateFormat) << endl ;
+	cout << "Final date: " << Date::formatEpoch(m_data->dates.back(), m_data->dateFormat) << endl << endl;
 
-	cout << "Initial index: " << fixed << setprecision(2) << m_prices[0] << endl;
-	cout << "Final index: " << fixed << setprecision(2) << m_prices.back() << endl;
-	cout << "Index return: " << fixed << setprecision(2) << 100 * (m_prices.back() - m_prices[0]) / m_prices[0] << "%" << endl << endl;
+	cout << "Initial index: " << fixed << setprecision(2) << m_data->prices[0] << endl;
+	cout << "Final index: " << fixed << setprecision(2) << m_data->prices.back() << endl;
+	cout << "Index return: " << fixed << setprecision(2) << 100 * (m_data->prices.back() - m_data->prices[0]) / m_data->prices[0] << "%" << endl << endl;
 
-	cout << "Initial portfolio value: " << fixed << setprecision(2) << m_portfolio_value[0] << endl;
-	cout << "Final portfolio value: " << fixed << setprecision(2) << m_portfolio_value.back() << endl;
-	cout << "portfolio return: " << fixed << setprecision(2) << 100 * (m_portfolio_value.back() - m_portfolio_value[0]) / m_portfolio_value[0] << "%" << endl << endl;
+	cout << "Initial portfolio value: " << fixed << setprecision(2) << m_initial_portfolio_value << endl;
+	cout << "Final portfolio value: " << fixed << setprecision(2) << m_final_portfolio_value << endl;
+	cout << "portfolio return: " << fixed << setprecision(2) << 100 * (m_final_portfolio_value - m_initial_portfolio_value) / m_initial_portfolio_value << "%" << endl << endl;
 
 	cout << endl << "Trades statistics:" << endl << endl;
 
@@ -354,23 +676,34 @@ void WhiteRobot::printResults() {
 void WhiteRobot::saveSimulation(string fileName) {
 
 	ofstream file_out;
+	file_out.open(fileName, ios_base::app);
+	writeSimulation(file_out);
+
+	//cout << endl << "Simulation results added to: "<< fileName << endl;
+
+}
+
+// Write the backtest simulation results as one CSV row
+void WhiteRobot::writeSimulation(ostream& file_out) {
 
 	// File format:
 	//simulation_date, intial_date, final_date, initial_index, final_index, index_return, initial_porfolio, final_porfolio, portfolio_return, long_trades, good_long_trades, long_trades_profit,long_stop_loss, short_trades, good_short_trades, short_trades_profit, short_stop_loss, small_ma_long, medium_ma_long, large_ma_long, min_slope_long, sm_mode_long, small_ma_short, medium_ma_short, large_ma_short, min_slope_short, sm_mode_short, slope_points, stop_loss
+	// Simulations a sweep pruned add a last field, "pruned <date>", their final portfolio is the one of that date
 
 
-	file_out.open(fileName, ios_base::app);
-
+	if (m_data->dates.empty()) {
+		return;
+	}
 	file_out << getTimeStr() << ",";
-	file_out << m_dates[0] << ",";
-	file_out << m_dates.back() << ",";
-	file_out << fixed << setprecision(2) << m_prices[0] << ",";
-	file_out << fixed << setprecision(2) << m_prices.back() << ",";
-	file_out << fixed << setprecision(2) << 100 * (m_prices.back() - m_prices[0]) / m_prices[0] << "%" << ",";
+	file_out << Date::formatEpoch(m_data->dates[0], m_data->dateFormat) << ",";
+	file_out << Date::formatEpoch(m_data->dates.back(), m_data->dateFormat) << ",";
+	file_out << fixed << setprecision(2) << m_data->prices[0] << ",";
+	file_out << fixed << setprecision(2) << m_data->prices.back() << ",";
+	file_out << fixed << setprecision(2) << 100 * (m_data->prices.back() - m_data->prices[0]) / m_data->prices[0] << "%" << ",";
 
-	file_out << fixed << setprecision(2) << m_portfolio_value[0] << ",";
-	file_out << fixed << setprecision(2) << m_portfolio_value.back() << ",";
-	file_out << fixed << setprecision(2) << 100 * (m_portfolio_value.back() - m_portfolio_value[0]) / m_portfolio_value[0] << "%" << ",";
+	file_out << fixed << setprecision(2) << m_initial_portfolio_value << ",";
+	file_out << fixed << setprecision(2) << m_final_portfolio_value << ",";
+	file_out << fixed << setprecision(2) << 100 * (m_final_portfolio_value - m_initial_portfolio_value) / m_initial_portfolio_value << "%" << ",";
 
 	file_out << m_long_trades << ",";
 	file_out << m_good_long_trades << ",";
@@ -395,10 +728,11 @@ void WhiteRobot::saveSimulation(string fileName) {
 	file_out << m_mode_short << ",";
 
 	file_out << m_slopePoints << ",";
-	file_out << fixed << setprecision(4) << m_stopLoss << endl;
-
-	//cout << endl << "Simulation results added to: "<< fileName << endl;
-
+	file_out << fixed << setprecision(4) << m_stopLoss;
+	if (m_pruned_point > 0) {
+		file_out << ",pruned " << Date::formatEpoch(m_data->dates[m_pruned_point], m_data->dateFormat);
+	}
+	file_out << endl;
 }
 
 // Genereate a new backtest simulation CSV data file
@@ -428,9 +762,9 @@ void WhiteRobot::saveSimulationData(string fileName) {
 
 
 	// write data to the file
-	for (int i = 0; i != m_prices.size(); i++) {
-		file_out << m_dates[i] << ",";
-		file_out << m_prices[i] << ",";
+	for (int i = 0; i != m_data->prices.size(); i++) {
+		file_out << Date::formatEpoch(m_data->dates[i], m_data->dateFormat) << ",";
+		file_out << m_data->prices[i] << ",";
 		file_out << m_ma_small_long[i] << ",";
 		file_out << m_ma_medium_long[i] << ",";
 		file_out << m_ma_large_long[i] << ",";
@@ -35,15 +35,90 @@
 #include <algorithm>
 #include <chrono>
 #include <ctime>
-#include "Signal_Generator.h"
+#include <limits>
+#include <memory>
+#include <mutex>
+#include "IndicatorTable.h"
+#include "EventIndex.h"
 #include "WhiteStrategy.h"
 #include "Date.h"
+#include "PriceSeries.h"
 using namespace std;
 
+class ThreadPool;
+
 /****************************************************************************************
 *									CLASS DECLARATION									*
 ****************************************************************************************/
 
+// Price series of a robot with its indicator table and crossings. Robots only read it once
+// built (the crossings fill in on first use, under a lock), so one instance is shared by all
+// the robots of a sweep. Not copyable: the table and the crossings point into prices.
+struct MarketData {
+	MarketData() : dateFormat(Date::ISO_HMS) {}
+	MarketData(const MarketData&) = delete;
+	MarketData& operator=(const MarketData&) = delete;
+
+	vector<long long> dates; // Contains all the asset class dates as epoch seconds
+	int dateFormat; // Date::Format used to print dates
+	vector<double> prices; // Contains the closing prices of the asset class
+	IndicatorTable indicators; // Prefix sums of prices
+	EventIndex events; // Crossings of the averages and price extremes, for EventBacktester
+};
+
+// Strategy parameters of one robot, in the order of setParameters
+struct RobotParameters {
+	int maPointsS_long;
+	int maPointsM_long;
+	int maPointsL_long;
+	double slopeMin_long;
+	int mode_long;
+	int maPointsS_short;
+	int maPointsM_short;
+	int maPointsL_short;
+	double slopeMin_short;
+	int mode_short;
+	int slopePoints;
+	double stopLoss;
+};
+
+// Results of one simulation as saveSimulation writes them
+struct StrategyStatistics {
+	double initial_portfolio_value;
+	double final_portfolio_value;
+	int long_trades;
+	int good_long_trades;
+	double long_trades_profit;
+	int long_stop_loss;
+	int short_trades;
+	int good_short_trades;
+	double short_trades_profit;
+	int short_stop_loss;
+	int pruned_point; // Point where a PruningRule stopped the simulation, 0 if it ran to the end
+};
+
+// Early stop of the simulations of a sweep, off unless checkpointPoints is positive. At the
+// points multiple of checkpointPoints after its first point, a robot whose portfolio value is
+// below minValue, or has lost more than maxDrawdown of the highest value it had at the
+// previous checks (the initial cash at first), stops there. Robots never stopped give the
+// same results as without the rule.
+struct PruningRule {
+	PruningRule() : checkpointPoints(0), minValue(0), maxDrawdown(1) {}
+
+	bool enabled() const { return checkpointPoints > 0; }
+
+	// True when a robot at checkpoint with portfolio value, and peak the highest value of
+	// its previous checks, stops. Updates peak
+	bool prunes(double value, double& peak) const {
+		peak = max(peak, value);
+		return value < minValue || value < (1 - maxDrawdown) * peak;
+	}
+
+	int checkpointPoints; // Points between checks
+	double minValue; // Lowest portfolio value allowed at a check
+	double maxDrawdown; // Largest loss allowed from the peak, as a fraction of it
+};
+
 class WhiteRobot
 {
 
@@ -52,24 +127,37 @@ public:
 	//constructors
 
 	WhiteRobot(): m_maPointsS_long(1), m_maPointsM_long(2), m_maPointsL_long(3), m_slopeMin_long(0.1), m_mode_long(1), m_maPointsS_short(1), m_maPointsM_short(2), m_maPointsL_short(3), m_slopeMin_short(0.1), m_mode_short(1),
-	m_slopePoints(4), m_stopLoss(0.1), m_point(0), m_state(1), m_long_stop_loss(0), m_short_stop_loss(0), m_long_trades(0), m_short_trades(0), m_good_long_trades(0), m_good_short_trades(0), m_long_trades_profit(0),
-	m_short_trades_profit(0) {}
+	m_slopePoints(4), m_stopLoss(0.1), m_data(make_shared<MarketData>()), m_point(0), m_state(1), m_long_stop_loss(0), m_short_stop_loss(0), m_long_trades(0), m_short_trades(0), m_good_long_trades(0), m_good_short_trades(0), m_long_trades_profit(0),
+	m_short_trades_profit(0), m_initial_portfolio_value(0), m_final_portfolio_value(0), m_pruned_point(0) {}
 
 	WhiteRobot(int maPointsS_long,	int maPointsM_long, int maPointsL_long, double slopeMin_long, int mode_long, int maPointsS_short, int maPointsM_short, int maPointsL_short, double slopeMin_short, int mode_short, int slopePoints,	double stopLoss):
 	m_maPointsS_long(maPointsS_long), m_maPointsM_long(maPointsM_long), m_maPointsL_long(maPointsL_long), m_slopeMin_long(slopeMin_long), m_mode_long(mode_long), m_maPointsS_short(maPointsS_short), m_maPointsM_short(maPointsM_short),
-	m_maPointsL_short(maPointsL_short), m_slopeMin_short(slopeMin_short), m_mode_short(mode_short), m_slopePoints(slopePoints), m_stopLoss(stopLoss), m_point(0), m_state(1), m_long_stop_loss(0), m_short_stop_loss(0), m_long_trades(0),
-	m_short_trades(0), m_good_long_trades(0), m_good_short_trades(0), m_long_trades_profit(0), m_short_trades_profit(0) {}
+	m_maPointsL_short(maPointsL_short), m_slopeMin_short(slopeMin_short), m_mode_short(mode_short), m_slopePoints(slopePoints), m_stopLoss(stopLoss), m_data(make_shared<MarketData>()), m_point(0), m_state(1), m_long_stop_loss(0), m_short_stop_loss(0), m_long_trades(0),
+	m_short_trades(0), m_good_long_trades(0), m_good_short_trades(0), m_long_trades_profit(0), m_short_trades_profit(0),
+	m_initial_portfolio_value(0), m_final_portfolio_value(0), m_pruned_point(0) {}
 
 
 	//Getters and setters
 
 	void setParameters(int maPointsS_long, int maPointsM_long, int maPointsL_long, double slopeMin_long, int mode_long, int maPointsS_short, int maPointsM_short, int maPointsL_short, double slopeMin_short, int mode_short, int slopePoints, double stopLoss);
 
+	void setParameters(const RobotParameters& parameters);
+
 	vector<double> getPrices();
 
+	shared_ptr<const MarketData> getData() const { return m_data; }
+
+	StrategyStatistics getStatistics() const;
+
+	// Portfolio value at every point of the last RunStrategy
+	const vector<double>& getPortfolioValues() const { return m_portfolio_value; }
+
+	// Results computed elsewhere (BatchBacktester) for the current parameters
+	void setStatistics(const StrategyStatistics& statistics);
+
 	void printPrices();
 
-	string getTimeStr();
+	static string getTimeStr();
 
 
 	//public member functions	
@@ -80,14 +168,36 @@ public:
 
 	void loadSelectedData(string fileName, string from, string to);
 
-	void generateSignals(vector<double> prices_window);
+	void setData(const PriceView& view);
 
+	void shareData(const WhiteRobot& source);
+
+	// Moving averages and slope of every point from m_point on, in chunks on pool (nullptr
+	// computes them on the calling thread)
+	void generateSignals(ThreadPool* pool);
+
+	// Indicators first (generateSignals), then the state machine and the orders point by point.
+	// The indicators are computed on the shared pool, or inline when called from a pool worker
 	void RunStrategy(double intialCash);
 
+	// Same, the indicators computed on pool (nullptr on the calling thread)
+	void RunStrategy(double intialCash, ThreadPool* pool);
+
+	// Same simulation keeping only the statistics saveSimulation needs, per point vectors stay empty
+	void RunStrategySummary(double intialCash);
+
+	// Same, stopped at the first check pruning fails (m_pruned_point), as the sweep backtesters do
+	void RunStrategySummary(double intialCash, const PruningRule& pruning);
+
+	// RunStrategySummary for every stop loss of stopLosses, the other parameters as set
+	vector<StrategyStatistics> RunStrategyStopLosses(double intialCash, const vector<double>& stopLosses);
+
 	void printResults();
 	
 	void saveSimulation(string fileName);
 
+	void writeSimulation(ostream& file_out);
+
 	void saveSimulationData(string fileName);
 
 	//Creates a friend class to WhiteStategy in order to access private member variables
@@ -95,6 +205,17 @@ public:
 
 private:
 
+	//private member functions
+
+	void appendData(const PriceView& view);
+
+	void readSignals(int point, double& slope, MovingAverages& ma_long, MovingAverages& ma_short);
+
+	void settleSignals(int point, double& slope, MovingAverages& ma_long, MovingAverages& ma_short);
+
+	// Capacity of a point per price in every per point vector
+	void reserveBuffers();
+
 	//private variable members
 
 	int m_maPointsS_long; // Long Moving Average Variable (Small)
@@ -113,8 +234,7 @@ private:
 	double m_stopLoss; // Stop Loss
 
 
-	vector<string> m_dates; // Contains all the asset class dates
-	vector<double> m_prices; // Contains the closing prices of the asset class
+	shared_ptr<const MarketData> m_data; // Dates, prices and indicator table, read-only and shared between robots
 	vector<double> m_volume; // Contains the volume of the asset class
 
 
@@ -127,6 +247,7 @@ private:
 
 	vector<double> m_slope; // Contains the slope values
 
+
 	int m_point; // Keeps track of the points
 	int m_state; // Keeps track of the current state of the state machine
 	int m_long_stop_loss; // Stores the long stop loss
@@ -138,6 +259,9 @@ private:
 	int m_good_short_trades; // Stores the No. of good short trades
 	double m_long_trades_profit; //Stores the profit made from long trades
 	double m_short_trades_profit; //Stores the profit made from short trades
+	double m_initial_portfolio_value; // Portfolio value before the first point of the simulation
+	double m_final_portfolio_value; // Portfolio value at the last point of the simulation
+	int m_pruned_point; // Point where a sweep stopped the simulation (PruningRule), 0 if it ran to the end
 
 	vector<int> m_state_signal; // Keeps a track of the state signal throughout the simulation process
 	vector<int> m_order_signal; //Keep a track of the order signal throughout the simulation process
@@ -151,7 +275,5 @@ private:
 
 	//Brain of the Robot
     WhiteStrategy ws;
-    //Signal Generator
-    Signal_Generator generate;
 };
 
@@ -20,13 +20,25 @@
 *								#INCLUDES AND #CONSTANTS								*
 ****************************************************************************************/
 #include "RobotMenu.h"
+#include "Benchmark.h"
+#include <string>
 /****************************************************************************************
 *									APPLICATION MAIN									*
 ****************************************************************************************/
 
-int main()
+int main(int argc, char* argv[])
 
 {
+    // WhiteRobotC --benchmark <data file>: runs the benchmarks, the exit status is 1 if a check fails
+    if (argc == 3 && std::string(argv[1]) == "--benchmark") {
+        PriceSeries series;
+        if (!series.load(argv[2])) {
+            return 1;
+        }
+        Benchmark benchmark(series);
+        return benchmark.runAll() ? 0 : 1;
+    }
+
     RobotMenu menu;
     menu.mainMenu();
 	return 0;
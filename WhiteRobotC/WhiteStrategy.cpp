@@ -4,6 +4,69 @@
 
 #include "WhiteStrategy.h"
 
+#include <array>
+#include <utility>
+
+namespace {
+
+    // Next state for [side][mode][state][crossings of the averages of that side], side 0 long
+    // and 1 short, see WhiteStrategy::sideTransition
+    struct StateTable {
+        signed char next[2][8][8][16];
+    };
+
+    constexpr StateTable makeStateTable() {
+        StateTable table = {};
+        for (int side = 0; side < 2; ++side) {
+            for (int mode = 0; mode < 8; ++mode) {
+                for (int state = 1; state < 8; ++state) {
+                    // Phase 0 is state 1, phases 1 to 3 are states 2 to 4 (long) or 5 to 7 (short)
+                    int phase = side == 0 ? (state <= 4 ? state - 1 : 0) : (state >= 5 ? state - 4 : 0);
+                    for (int crossed = 0; crossed < 16; ++crossed) {
+                        int events = side == 0 ? crossed : WhiteStrategy::shortEvents(crossed);
+                        int next = WhiteStrategy::sideTransition(mode, phase, events);
+                        table.next[side][mode][state][crossed] = static_cast<signed char>(next == 0 ? 1 : (side == 0 ? 1 : 4) + next);
+                    }
+                }
+            }
+        }
+        return table;
+    }
+
+    constexpr StateTable kStateTable = makeStateTable();
+
+    // Side the state reacts to, or -1 when it stays in state 1. Both trends are only followed
+    // when long trades are on
+    inline int tradedSide(int m_state, double slope, double m_slopeMin_long, int m_mode_long, double m_slopeMin_short) {
+        if (m_state == 1) {
+            if (m_mode_long == 0) {
+                return -1;
+            }
+            if (slope >= m_slopeMin_long) {
+                return 0;
+            }
+            return slope < -m_slopeMin_short ? 1 : -1;
+        }
+        if (m_state >= 2 && m_state <= 7) {
+            return m_state > 4;
+        }
+        return -1;
+    }
+
+    // Modes other than 1 to 7 never change the state, as mode 0
+    inline int tableMode(int mode) {
+        return static_cast<unsigned>(mode) < 8 ? mode : 0;
+    }
+
+    // WhiteStrategy::nextState kernel of every pair of kernel modes, at 8 * ModeLong + ModeShort
+    template <int... Pairs>
+    constexpr std::array<WhiteStrategy::StateKernel, 72> makeStateKernels(std::integer_sequence<int, Pairs...>) {
+        return {{ &WhiteStrategy::nextState<Pairs / 8, Pairs % 8>... }};
+    }
+
+    const std::array<WhiteStrategy::StateKernel, 72> kStateKernels = makeStateKernels(std::make_integer_sequence<int, 72>());
+}
+
 
 WhiteStrategy::WhiteStrategy() {}
 
@@ -25,105 +88,131 @@ int WhiteStrategy::stateAnalyser(int &m_state)
     }
 }
 
-// State machine containing the brain (logic) of the robot
-int WhiteStrategy::whiteStateMachine(double &last_trade_investment,int &m_state, std::vector<double> &m_slope, int &m_point,
-                                     double &m_slopeMin_long, int &m_mode_long, std::vector<double> &m_ma_small_long, std::vector<double> &m_ma_medium_long,
-                                     std::vector<double> &m_ma_large_long, double &m_slopeMin_short, std::vector<double> &m_ma_small_short,
-                                     std::vector<double> &m_ma_medium_short,std::vector<double> &m_ma_large_short, int &m_mode_short,
-                                     std::vector<int> &m_state_signal,std::vector<double> &m_portfolio_value, std::vector<int> &m_stop_loss,
-                                     int &m_long_stop_loss, double &m_stopLoss, int &m_short_stop_loss, std::vector<double> &m_prices) {
+// Transition of the state machine for the indicators of one point, stop loss excluded. Only
+// the crossings of the side the state reacts to are computed
+int WhiteStrategy::nextState(int m_state, double slope, const MovingAverages &current_long, const MovingAverages &previous_long,
+                             const MovingAverages &current_short, const MovingAverages &previous_short,
+                             double m_slopeMin_long, int m_mode_long, double m_slopeMin_short, int m_mode_short) {
 
-    if (checkStopLoss(last_trade_investment, m_portfolio_value, m_point, m_state, m_stop_loss, m_long_stop_loss, m_stopLoss, m_short_stop_loss, m_prices)) {
-        // Slop loss limit reached in the previous point
-        m_state = 1;
-    } else if (m_state == 1) {
-        if (m_slope[m_point] >= m_slopeMin_long && m_mode_long != 0) {
+    int side = tradedSide(m_state, slope, m_slopeMin_long, m_mode_long, m_slopeMin_short);
+    if (side < 0) {
+        return 1;
+    }
+    if (side == 0) {
+        return kStateTable.next[0][tableMode(m_mode_long)][m_state][crossings(current_long, previous_long)];
+    }
+    return kStateTable.next[1][tableMode(m_mode_short)][m_state][crossings(current_short, previous_short)];
+}
+
+WhiteStrategy::StateKernel WhiteStrategy::stateKernel(int m_mode_long, int m_mode_short) {
+    return kStateKernels[8 * kernelModeLong(m_mode_long) + kernelModeShort(m_mode_short)];
+}
+
+// Same transition from the Crossing bits of the long and short averages
+int WhiteStrategy::nextState(int m_state, double slope, int long_crossings, int short_crossings,
+                             double m_slopeMin_long, int m_mode_long, double m_slopeMin_short, int m_mode_short) {
+
+    int side = tradedSide(m_state, slope, m_slopeMin_long, m_mode_long, m_slopeMin_short);
+    if (side < 0) {
+        return 1;
+    }
+    return side == 0 ? kStateTable.next[0][tableMode(m_mode_long)][m_state][long_crossings]
+                     : kStateTable.next[1][tableMode(m_mode_short)][m_state][short_crossings];
+}
+
+// Original if/else version of nextState, kept as the reference the table is checked against
+int WhiteStrategy::branchingNextState(int m_state, double slope, const MovingAverages &current_long, const MovingAverages &previous_long,
+                             const MovingAverages &current_short, const MovingAverages &previous_short,
+                             double m_slopeMin_long, int m_mode_long, double m_slopeMin_short, int m_mode_short) {
+
+    if (m_state == 1) {
+        if (slope >= m_slopeMin_long && m_mode_long != 0) {
             //positive trend
-            if ((m_ma_small_long[m_point] > m_ma_medium_long[m_point]) && (m_ma_small_long[m_point - 1] < m_ma_medium_long[m_point - 1]) && (m_mode_long == 1 || m_mode_long == 2 || m_mode_long == 3)) {
+            if ((current_long.small > current_long.medium) && (previous_long.small < previous_long.medium) && (m_mode_long == 1 || m_mode_long == 2 || m_mode_long == 3)) {
                 //S>M  big cycle
                 m_state = 2;
             }
-            else if ((m_ma_small_long[m_point] > m_ma_large_long[m_point]) && (m_ma_small_long[m_point - 1] < m_ma_large_long[m_point - 1]) && (m_mode_long == 4 || m_mode_long == 5 )) {
+            else if ((current_long.small > current_long.large) && (previous_long.small < previous_long.large) && (m_mode_long == 4 || m_mode_long == 5 )) {
                 //S>L
                 m_state = 3;
             }
-            else if ((m_ma_small_long[m_point] > m_ma_medium_long[m_point]) && (m_ma_small_long[m_point - 1] < m_ma_medium_long[m_point - 1]) && (m_mode_long == 6 || m_mode_long == 7 )) {
+            else if ((current_long.small > current_long.medium) && (previous_long.small < previous_long.medium) && (m_mode_long == 6 || m_mode_long == 7 )) {
                 //S>M small cycle
                 m_state = 4;
             }
         }
-        else if (m_slope[m_point] < -m_slopeMin_short && m_mode_long != 0) {
+        else if (slope < -m_slopeMin_short && m_mode_long != 0) {
             //negative trend
-            if ((m_ma_small_short[m_point] < m_ma_medium_short[m_point]) && (m_ma_small_short[m_point - 1] > m_ma_medium_short[m_point - 1]) && (m_mode_short == 1 || m_mode_short == 2 || m_mode_short == 3)) {
+            if ((current_short.small < current_short.medium) && (previous_short.small > previous_short.medium) && (m_mode_short == 1 || m_mode_short == 2 || m_mode_short == 3)) {
                 //S<M big cycle
                 m_state = 5;
             }
-            else if ((m_ma_small_short[m_point] < m_ma_large_short[m_point]) && (m_ma_small_short[m_point - 1] > m_ma_large_short[m_point - 1]) && (m_mode_short == 4 || m_mode_short == 5)) {
+            else if ((current_short.small < current_short.large) && (previous_short.small > previous_short.large) && (m_mode_short == 4 || m_mode_short == 5)) {
                 //S<L
                 m_state = 6;
             }
-            else if ((m_ma_small_short[m_point] < m_ma_medium_short[m_point]) && (m_ma_small_short[m_point - 1] > m_ma_medium_short[m_point - 1]) && (m_mode_short == 6 || m_mode_short == 7)) {
+            else if ((current_short.small < current_short.medium) && (previous_short.small > previous_short.medium) && (m_mode_short == 6 || m_mode_short == 7)) {
                 //S<M small cycle
                 m_state = 7;
             }
         }
     }
     else if (m_state == 2) {
-        if ((m_ma_small_long[m_point] > m_ma_large_long[m_point]) && (m_ma_small_long[m_point - 1] < m_ma_large_long[m_point - 1]) && (m_mode_long == 1 || m_mode_long == 2)) {
+        if ((current_long.small > current_long.large) && (previous_long.small < previous_long.large) && (m_mode_long == 1 || m_mode_long == 2)) {
             //S>L big cycle
             m_state = 3;
         }
-        else if ((m_ma_small_long[m_point] > m_ma_large_long[m_point]) && (m_ma_small_long[m_point - 1] < m_ma_large_long[m_point - 1]) && (m_mode_long == 3)) {
+        else if ((current_long.small > current_long.large) && (previous_long.small < previous_long.large) && (m_mode_long == 3)) {
             //S>L medium cycle
             m_state = 4;
         }
     }
     else if (m_state == 3) {
-        if ((m_ma_small_long[m_point] < m_ma_medium_long[m_point]) && (m_ma_small_long[m_point - 1] > m_ma_medium_long[m_point - 1]) && (m_mode_long == 1 || m_mode_long == 5)) {
+        if ((current_long.small < current_long.medium) && (previous_long.small > previous_long.medium) && (m_mode_long == 1 || m_mode_long == 5)) {
             //S<M
             m_state = 4;
         }
-        else if ((m_ma_small_long[m_point] < m_ma_large_long[m_point]) && (m_ma_small_long[m_point - 1] > m_ma_large_long[m_point - 1]) && (m_mode_long == 2 || m_mode_long == 4)) {
+        else if ((current_long.small < current_long.large) && (previous_long.small > previous_long.large) && (m_mode_long == 2 || m_mode_long == 4)) {
             //S<L
             m_state = 1;
         }
     }
     else if (m_state == 4) {
-        if ((m_ma_small_long[m_point] < m_ma_large_long[m_point]) && (m_ma_small_long[m_point - 1] > m_ma_large_long[m_point - 1]) && (m_mode_long == 1 || m_mode_long == 3 || m_mode_long == 5 || m_mode_long == 6 )) {
+        if ((current_long.small < current_long.large) && (previous_long.small > previous_long.large) && (m_mode_long == 1 || m_mode_long == 3 || m_mode_long == 5 || m_mode_long == 6 )) {
             //S<L
             m_state = 1;
         }
-        if ((m_ma_small_long[m_point] < m_ma_medium_long[m_point]) && (m_ma_small_long[m_point - 1] > m_ma_medium_long[m_point - 1]) && (m_mode_long == 7)) {
+        if ((current_long.small < current_long.medium) && (previous_long.small > previous_long.medium) && (m_mode_long == 7)) {
             //S<M
             m_state = 1;
         }
     }
     else if (m_state == 5) {
-        if ((m_ma_small_short[m_point] < m_ma_large_short[m_point]) && (m_ma_small_short[m_point - 1] > m_ma_large_short[m_point - 1]) && (m_mode_short == 1 || m_mode_short == 2)) {
+        if ((current_short.small < current_short.large) && (previous_short.small > previous_short.large) && (m_mode_short == 1 || m_mode_short == 2)) {
             //S<L big cycle
             m_state = 6;
         }
-        else if ((m_ma_small_short[m_point] < m_ma_large_short[m_point]) && (m_ma_small_short[m_point - 1] > m_ma_large_short[m_point - 1]) && (m_mode_short == 3)) {
+        else if ((current_short.small < current_short.large) && (previous_short.small > previous_short.large) && (m_mode_short == 3)) {
             //S<L medium cycle
             m_state = 7;
         }
     }
     else if (m_state == 6) {
-        if ((m_ma_small_short[m_point] > m_ma_medium_short[m_point]) && (m_ma_small_short[m_point - 1] < m_ma_medium_short[m_point - 1]) && (m_mode_short == 1 || m_mode_short == 5)) {
+        if ((current_short.small > current_short.medium) && (previous_short.small < previous_short.medium) && (m_mode_short == 1 || m_mode_short == 5)) {
             //S>M
             m_state = 7;
         }
-        else if ((m_ma_small_short[m_point] > m_ma_large_short[m_point]) && (m_ma_small_short[m_point - 1] < m_ma_large_short[m_point - 1]) && (m_mode_short == 2 || m_mode_short == 4)) {
+        else if ((current_short.small > current_short.large) && (previous_short.small < previous_short.large) && (m_mode_short == 2 || m_mode_short == 4)) {
             //S>L
             m_state = 1;
         }
     }
     else if (m_state == 7) {
-        if ((m_ma_small_short[m_point] > m_ma_large_short[m_point]) && (m_ma_small_short[m_point - 1] < m_ma_large_short[m_point - 1]) && (m_mode_short == 1 || m_mode_short == 3 || m_mode_short == 5 || m_mode_short == 6)) {
+        if ((current_short.small > current_short.large) && (previous_short.small < previous_short.large) && (m_mode_short == 1 || m_mode_short == 3 || m_mode_short == 5 || m_mode_short == 6)) {
             //S>L
             m_state = 1;
         }
-        else if ((m_ma_small_short[m_point] > m_ma_medium_short[m_point]) && (m_ma_small_short[m_point - 1] < m_ma_medium_short[m_point - 1]) && (m_mode_short == 7)) {
+        else if ((current_short.small > current_short.medium) && (previous_short.small < previous_short.medium) && (m_mode_short == 7)) {
             //S>M
             m_state = 1;
         }
@@ -132,6 +221,29 @@ int WhiteStrategy::whiteStateMachine(double &last_trade_investment,int &m_state,
         m_state = 1;
     }
 
+    return m_state;
+}
+
+// State machine containing the brain (logic) of the robot
+int WhiteStrategy::whiteStateMachine(double &last_trade_investment,int &m_state, std::vector<double> &m_slope, int &m_point,
+                                     double &m_slopeMin_long, std::vector<double> &m_ma_small_long, std::vector<double> &m_ma_medium_long,
+                                     std::vector<double> &m_ma_large_long, double &m_slopeMin_short, std::vector<double> &m_ma_small_short,
+                                     std::vector<double> &m_ma_medium_short,std::vector<double> &m_ma_large_short,
+                                     std::vector<int> &m_state_signal,std::vector<double> &m_portfolio_value, std::vector<int> &m_stop_loss,
+                                     int &m_long_stop_loss, double &m_stopLoss, int &m_short_stop_loss, const std::vector<double> &m_prices,
+                                     StateKernel kernel) {
+
+    if (checkStopLoss(last_trade_investment, m_portfolio_value, m_point, m_state, m_stop_loss, m_long_stop_loss, m_stopLoss, m_short_stop_loss, m_prices)) {
+        // Slop loss limit reached in the previous point
+        m_state = 1;
+    } else {
+        MovingAverages current_long = { m_ma_small_long[m_point], m_ma_medium_long[m_point], m_ma_large_long[m_point] };
+        MovingAverages previous_long = { m_ma_small_long[m_point - 1], m_ma_medium_long[m_point - 1], m_ma_large_long[m_point - 1] };
+        MovingAverages current_short = { m_ma_small_short[m_point], m_ma_medium_short[m_point], m_ma_large_short[m_point] };
+        MovingAverages previous_short = { m_ma_small_short[m_point - 1], m_ma_medium_short[m_point - 1], m_ma_large_short[m_point - 1] };
+        m_state = kernel(m_state, m_slope[m_point], current_long, previous_long, current_short, previous_short,
+                         m_slopeMin_long, m_slopeMin_short);
+    }
 
     m_state_signal.push_back(m_state);
     // Return the order signal according to the state
@@ -140,108 +252,124 @@ int WhiteStrategy::whiteStateMachine(double &last_trade_investment,int &m_state,
 
 // Analyses the current and previous order signal to determine the current portfolio value
 double WhiteStrategy::orderAnalyser(double& current_cash, double& last_trade_investment, double& cfd_units,std::vector<int> &m_order_signal,
-                                    int &m_point, std::vector<double> &m_prices, int &m_long_trades, int &m_short_trades, double &m_long_trades_profit,
+                                    int &m_point, const std::vector<double> &m_prices, int &m_long_trades, int &m_short_trades, double &m_long_trades_profit,
                                     std::vector<double> &m_trade_profit, int &m_good_long_trades, double &m_short_trades_profit, int &m_good_short_trades,
                                     std::vector<double> &m_current_cash, std::vector<double> &m_cfd_units, std::vector<double> &m_last_trade_investment)
 {
+        double trade_profit;
+        double portfolio_value = executeOrder(m_order_signal[m_point], m_order_signal[m_point - 1], m_prices[m_point], current_cash,
+                                              last_trade_investment, cfd_units, m_long_trades, m_short_trades, m_long_trades_profit,
+                                              m_good_long_trades, m_short_trades_profit, m_good_short_trades, trade_profit);
+
+        m_trade_profit.push_back(trade_profit);
+        m_current_cash.push_back(current_cash);
+        m_cfd_units.push_back(cfd_units);
+        m_last_trade_investment.push_back(last_trade_investment);
+
+        //Return the current porfolio value
+        return portfolio_value;
+    }
+
+// Updates the investment position for the order signal of one point and returns the portfolio value
+double WhiteStrategy::executeOrder(int order, int previous_order, double price, double& current_cash, double& last_trade_investment,
+                                   double& cfd_units, int &m_long_trades, int &m_short_trades, double &m_long_trades_profit,
+                                   int &m_good_long_trades, double &m_short_trades_profit, int &m_good_short_trades, double &trade_profit)
+{
 
         double portfolio_value;
 
         // Evaluate order signals and update invesment position variables
-        if (m_order_signal[m_point] == 1 && m_order_signal[m_point - 1] == 0) {
+        if (order == 1 && previous_order == 0) {
             //Start Long trade
             last_trade_investment = current_cash;
             current_cash = 0;
-            cfd_units = last_trade_investment / m_prices[m_point];
+            cfd_units = last_trade_investment / price;
             ++m_long_trades;
         }
-        else if (m_order_signal[m_point] == 0 && m_order_signal[m_point - 1] == 1) {
+        else if (order == 0 && previous_order == 1) {
             //Stop Long trade
-            current_cash = cfd_units* m_prices[m_point];
+            current_cash = cfd_units* price;
             cfd_units = 0;
         }
-        else if (m_order_signal[m_point] == -1 && m_order_signal[m_point - 1] == 0) {
+        else if (order == -1 && previous_order == 0) {
             //Start short trade
             last_trade_investment = current_cash;
             current_cash = 0;
-            cfd_units = last_trade_investment / m_prices[m_point];
+            cfd_units = last_trade_investment / price;
             ++m_short_trades;
         }
-        else if (m_order_signal[m_point] == 0 && m_order_signal[m_point - 1] == -1) {
+        else if (order == 0 && previous_order == -1) {
             //Stop short trade
-            current_cash = 2* last_trade_investment - cfd_units * m_prices[m_point];
+            current_cash = 2* last_trade_investment - cfd_units * price;
             cfd_units = 0;
         }
 
         //Calculate the porfolio value
-        if (m_order_signal[m_point] == 1) {
-            portfolio_value = current_cash + cfd_units * m_prices[m_point];
+        if (order == 1) {
+            portfolio_value = current_cash + cfd_units * price;
         }
-        else if (m_order_signal[m_point] == -1) {
-            portfolio_value = current_cash + 2 * last_trade_investment - cfd_units * m_prices[m_point];
+        else if (order == -1) {
+            portfolio_value = current_cash + 2 * last_trade_investment - cfd_units * price;
         }
         else {
             portfolio_value = current_cash;
         }
 
         // Calculate trade profit and performance
-        if (m_order_signal[m_point] == 0 && m_order_signal[m_point - 1] == 1) {
+        if (order == 0 && previous_order == 1) {
             //Long trade detected
             m_long_trades_profit += portfolio_value - last_trade_investment;
-            m_trade_profit.push_back(portfolio_value - last_trade_investment);
+            trade_profit = portfolio_value - last_trade_investment;
             if (portfolio_value > last_trade_investment) {
                 //Succesfull long trade
                 ++m_good_long_trades;
             }
         }
-        else if (m_order_signal[m_point] == 0 && m_order_signal[m_point - 1] == -1) {
+        else if (order == 0 && previous_order == -1) {
             //short trade detected
             m_short_trades_profit += portfolio_value - last_trade_investment;
-            m_trade_profit.push_back(portfolio_value - last_trade_investment);
+            trade_profit = portfolio_value - last_trade_investment;
             if (portfolio_value > last_trade_investment) {
                 ++m_good_short_trades;
             }
         }
         else {
-            m_trade_profit.push_back(0);
+            trade_profit = 0;
         }
 
-        m_current_cash.push_back(current_cash);
-        m_cfd_units.push_back(cfd_units);
-        m_last_trade_investment.push_back(last_trade_investment);
-
-        //Return the current porfolio value
         return portfolio_value;
     }
 
 // Analyses if the stop loss condition has been reached
 bool WhiteStrategy::checkStopLoss(double &last_trade_investment,std::vector<double> &m_portfolio_value, int &m_point, int &m_state,
                                   std::vector<int> &m_stop_loss, int &m_long_stop_loss, double &m_stopLoss, int &m_short_stop_loss,
-                                  std::vector<double> &m_prices) {
+                                  const std::vector<double> &m_prices) {
+
+    bool stop = stopLossReached(last_trade_investment, m_portfolio_value[m_point-1], m_state, m_long_stop_loss, m_stopLoss,
+                                m_short_stop_loss, m_point == m_prices.size()-1);
+    m_stop_loss.push_back(stop ? 1 : 0);
+    return stop;
+}
 
-    double current_trade_profit = (m_portfolio_value[m_point-1] - last_trade_investment) / last_trade_investment;
+// Same test on the portfolio value of the previous point, the last point of the data always stops
+bool WhiteStrategy::stopLossReached(double last_trade_investment, double previous_portfolio_value, int m_state, int &m_long_stop_loss,
+                                    double m_stopLoss, int &m_short_stop_loss, bool last_point) {
+
+    double current_trade_profit = (previous_portfolio_value - last_trade_investment) / last_trade_investment;
 
     if ( (m_state == 3 || m_state == 4 ) &&  current_trade_profit < - m_stopLoss) {
-        m_stop_loss.push_back(1);
         m_long_stop_loss ++;
         return true;
     }
     else if ((m_state == 6 || m_state == 7) && current_trade_profit < - m_stopLoss) {
-        m_stop_loss.push_back(1);
         m_short_stop_loss ++;
         return true;
     }
-    else if (m_point == m_prices.size()-1) {
-        m_stop_loss.push_back(1);
+    else if (last_point) {
         return true;
     }
     else {
-        m_stop_loss.push_back(0);
         return false;
     }
 
-}
-
-
-
-
+}
\ No newline at end of file
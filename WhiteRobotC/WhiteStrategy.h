@@ -5,28 +5,144 @@
 #pragma once
 #include <vector>
 
+// Small, medium and large moving averages of one side (long or short) at one point
+struct MovingAverages {
+    double small;
+    double medium;
+    double large;
+};
+
 class WhiteStrategy
 {
 public:
 
+    // Crossings of the small average between two points, over (UP) or under (DOWN) the others
+    enum Crossing { UP_MEDIUM = 1, UP_LARGE = 2, DOWN_MEDIUM = 4, DOWN_LARGE = 8 };
+
+    // The same crossings seen from one side: a long trade enters on crossings up and exits on
+    // crossings down, a short trade the other way round
+    enum SideEvent { ENTER_MEDIUM = 1, ENTER_LARGE = 2, EXIT_MEDIUM = 4, EXIT_LARGE = 8 };
+
+    // nextState<ModeLong, ModeShort> of one pair of kernel modes, see stateKernel
+    typedef int (*StateKernel)(int m_state, double slope, const MovingAverages &current_long, const MovingAverages &previous_long,
+                               const MovingAverages &current_short, const MovingAverages &previous_short,
+                               double m_slopeMin_long, double m_slopeMin_short);
+
     WhiteStrategy();
     int stateAnalyser(int &m_state);
+    int nextState(int m_state, double slope, const MovingAverages &current_long, const MovingAverages &previous_long,
+                  const MovingAverages &current_short, const MovingAverages &previous_short,
+                  double m_slopeMin_long, int m_mode_long, double m_slopeMin_short, int m_mode_short);
+    int nextState(int m_state, double slope, int long_crossings, int short_crossings,
+                  double m_slopeMin_long, int m_mode_long, double m_slopeMin_short, int m_mode_short);
+    int branchingNextState(int m_state, double slope, const MovingAverages &current_long, const MovingAverages &previous_long,
+                           const MovingAverages &current_short, const MovingAverages &previous_short,
+                           double m_slopeMin_long, int m_mode_long, double m_slopeMin_short, int m_mode_short);
     int whiteStateMachine(double &last_trade_investment,int &m_state, std::vector<double> &m_slope, int &m_point,
-                          double &m_slopeMin_long, int &m_mode_long, std::vector<double> &m_ma_small_long, std::vector<double> &m_ma_medium_long,
+                          double &m_slopeMin_long, std::vector<double> &m_ma_small_long, std::vector<double> &m_ma_medium_long,
                           std::vector<double> &m_ma_large_long, double &m_slopeMin_short, std::vector<double> &m_ma_small_short,
-                          std::vector<double> &m_ma_medium_short,std::vector<double> &m_ma_large_short, int &m_mode_short,
+                          std::vector<double> &m_ma_medium_short,std::vector<double> &m_ma_large_short,
                           std::vector<int> &m_state_signal,std::vector<double> &m_portfolio_value, std::vector<int> &m_stop_loss,
-                          int &m_long_stop_loss, double &m_stopLoss, int &m_short_stop_loss, std::vector<double> &m_prices);
+                          int &m_long_stop_loss, double &m_stopLoss, int &m_short_stop_loss, const std::vector<double> &m_prices,
+                          StateKernel kernel);
     double orderAnalyser(double& current_cash, double& last_trade_investment, double& cfd_units,std::vector<int> &m_order_signal,
-                                        int &m_point, std::vector<double> &m_prices, int &m_long_trades, int &m_short_trades, double &m_long_trades_profit,
+                                        int &m_point, const std::vector<double> &m_prices, int &m_long_trades, int &m_short_trades, double &m_long_trades_profit,
                                         std::vector<double> &m_trade_profit, int &m_good_long_trades, double &m_short_trades_profit, int &m_good_short_trades,
                                         std::vector<double> &m_current_cash, std::vector<double> &m_cfd_units, std::vector<double> &m_last_trade_investment);
+    double executeOrder(int order, int previous_order, double price, double& current_cash, double& last_trade_investment,
+                        double& cfd_units, int &m_long_trades, int &m_short_trades, double &m_long_trades_profit,
+                        int &m_good_long_trades, double &m_short_trades_profit, int &m_good_short_trades, double &trade_profit);
     bool checkStopLoss(double &last_trade_investment,std::vector<double> &m_portfolio_value, int &m_point, int &m_state,
                                       std::vector<int> &m_stop_loss, int &m_long_stop_loss, double &m_stopLoss, int &m_short_stop_loss,
-                                      std::vector<double> &m_prices);
+                                      const std::vector<double> &m_prices);
+    bool stopLossReached(double last_trade_investment, double previous_portfolio_value, int m_state, int &m_long_stop_loss,
+                         double m_stopLoss, int &m_short_stop_loss, bool last_point);
     bool trailingStopLoss();
+
+    // nextState with the modes fixed at compile time, only the crossings the modes react to
+    // are tested. Other modes behave as ModeLong 8 and ModeShort 0, see kernelMode
+    template <int ModeLong, int ModeShort>
+    static int nextState(int m_state, double slope, const MovingAverages &current_long, const MovingAverages &previous_long,
+                         const MovingAverages &current_short, const MovingAverages &previous_short,
+                         double m_slopeMin_long, double m_slopeMin_short);
+
+    // Kernel of the modes of a robot, chosen once before its simulation runs
+    static StateKernel stateKernel(int m_mode_long, int m_mode_short);
+
+    // Mode the kernels are instantiated for: 0 to 7, and 8 for the long modes that follow the
+    // trend without ever trading. A short mode outside 0 to 7 never trades, as 0
+    static int kernelModeLong(int m_mode_long) { return static_cast<unsigned>(m_mode_long) < 8 ? m_mode_long : 8; }
+    static int kernelModeShort(int m_mode_short) { return static_cast<unsigned>(m_mode_short) < 8 ? m_mode_short : 0; }
+
+    // Phase of one side after the side events, phase 0 is state 1 (not invested) and phases
+    // 1, 2, 3 are states 2, 3, 4 for long trades and 5, 6, 7 for short trades
+    static constexpr int sideTransition(int mode, int phase, int events) {
+        bool enter_medium = events & ENTER_MEDIUM;
+        bool enter_large = events & ENTER_LARGE;
+        bool exit_medium = events & EXIT_MEDIUM;
+        bool exit_large = events & EXIT_LARGE;
+
+        if (phase == 0) {
+            if (enter_medium && (mode == 1 || mode == 2 || mode == 3)) return 1; //big cycle
+            if (enter_large && (mode == 4 || mode == 5)) return 2;
+            if (enter_medium && (mode == 6 || mode == 7)) return 3; //small cycle
+        }
+        else if (phase == 1) {
+            if (enter_large && (mode == 1 || mode == 2)) return 2; //big cycle
+            if (enter_large && mode == 3) return 3; //medium cycle
+        }
+        else if (phase == 2) {
+            if (exit_medium && (mode == 1 || mode == 5)) return 3;
+            if (exit_large && (mode == 2 || mode == 4)) return 0;
+        }
+        else {
+            if (exit_large && (mode == 1 || mode == 3 || mode == 5 || mode == 6)) return 0;
+            if (exit_medium && mode == 7) return 0;
+        }
+        return phase;
+    }
+
+    static int crossings(const MovingAverages &current, const MovingAverages &previous) {
+        return ((current.small > current.medium) & (previous.small < previous.medium)) * UP_MEDIUM
+             | ((current.small > current.large) & (previous.small < previous.large)) * UP_LARGE
+             | ((current.small < current.medium) & (previous.small > previous.medium)) * DOWN_MEDIUM
+             | ((current.small < current.large) & (previous.small > previous.large)) * DOWN_LARGE;
+    }
+
+    // Side events of a short trade for the crossings of the short averages
+    static constexpr int shortEvents(int crossed) {
+        return (crossed >> 2) | ((crossed & 3) << 2);
+    }
 };
 
+template <int ModeLong, int ModeShort>
+int WhiteStrategy::nextState(int m_state, double slope, const MovingAverages &current_long, const MovingAverages &previous_long,
+                             const MovingAverages &current_short, const MovingAverages &previous_short,
+                             double m_slopeMin_long, double m_slopeMin_short) {
+
+    if (m_state == 1) {
+        if (ModeLong == 0) {
+            return 1;
+        }
+        if (slope >= m_slopeMin_long) {
+            return 1 + sideTransition(ModeLong, 0, crossings(current_long, previous_long));
+        }
+        if (slope < -m_slopeMin_short) {
+            int phase = sideTransition(ModeShort, 0, shortEvents(crossings(current_short, previous_short)));
+            return phase == 0 ? 1 : 4 + phase;
+        }
+        return 1;
+    }
+    if (m_state >= 2 && m_state <= 4) {
+        return 1 + sideTransition(ModeLong, m_state - 1, crossings(current_long, previous_long));
+    }
+    if (m_state >= 5 && m_state <= 7) {
+        int phase = sideTransition(ModeShort, m_state - 4, shortEvents(crossings(current_short, previous_short)));
+        return phase == 0 ? 1 : 4 + phase;
+    }
+    return 1;
+}
+
 
 
 
@@ -0,0 +1,131 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	WorkStealingScheduler.cpp
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Runs a set of independent jobs of uneven cost on the workers of a pool,
+*					idle workers steal pending jobs from the others.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+*					- R. D. Blumofe and C. E. Leiserson: Scheduling multithreaded
+*					  computations by work stealing. Journal of the ACM 46(5). 1999.
+* Other files	:	ThreadPool.cpp provides the threads.
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*								#INCLUDES AND #CONSTANTS								*
+****************************************************************************************/
+
+#include "WorkStealingScheduler.h"
+
+#include <chrono>
+#include <iomanip>
+
+/****************************************************************************************
+*									MEMBER FUNCTIONS									*
+****************************************************************************************/
+
+//constructors
+
+WorkStealingScheduler::WorkStealingScheduler(ThreadPool& pool) : m_pool(pool), m_elapsed(0) {
+	for (std::size_t i = 0; i < pool.size(); ++i) {
+		m_workers.emplace_back(new Worker());
+	}
+}
+
+
+//public member functions
+
+void WorkStealingScheduler::run(int jobCount, const Job& job) {
+	const int count = workers();
+	for (auto& worker : m_workers) {
+		worker->jobs.clear();
+		worker->executed = 0;
+		worker->stolen = 0;
+		worker->busy = 0;
+		worker->finished = 0;
+	}
+	for (int i = 0; i < jobCount; ++i) {
+		m_workers[(i / kBlockSize) % count]->jobs.push_back(i);
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::future<void>> loops;
+	for (int i = 0; i < count; ++i) {
+		loops.push_back(m_pool.submit([this, i, &job, start]() {
+			workerLoop(i, job);
+			m_workers[i]->finished = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		}));
+	}
+	// Every loop must be done with job before an exception leaves run
+	for (auto& loop : loops) {
+		loop.wait();
+	}
+	m_elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	for (auto& loop : loops) {
+		loop.get();
+	}
+}
+
+void WorkStealingScheduler::printUtilization(std::ostream& out) const {
+	out << std::endl << "Worker utilization over " << std::fixed << std::setprecision(3) << m_elapsed << " s:" << std::endl;
+	for (int i = 0; i < workers(); ++i) {
+		const Worker& worker = *m_workers[i];
+		double busy = m_elapsed > 0 ? 100 * worker.busy / m_elapsed : 0;
+		double finished = m_elapsed > 0 ? 100 * worker.finished / m_elapsed : 0;
+		out << " worker " << std::setw(2) << i << ": " << std::setw(6) << worker.executed << " jobs (" << worker.stolen << " stolen)"
+			<< std::setprecision(1) << "  busy " << std::setw(5) << busy << "%  done at " << std::setw(5) << finished << "%" << std::endl;
+	}
+	out << std::defaultfloat;
+}
+
+
+//private member functions
+
+void WorkStealingScheduler::workerLoop(int index, const Job& job) {
+	Worker& self = *m_workers[index];
+	int next;
+	for (;;) {
+		if (!popOwn(index, next)) {
+			// Jobs never add jobs, so once every deque is seen empty there is nothing left
+			if (!steal(index, next)) {
+				return;
+			}
+			++self.stolen;
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		job(index, next);
+		self.busy += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		++self.executed;
+	}
+}
+
+bool WorkStealingScheduler::popOwn(int index, int& job) {
+	Worker& self = *m_workers[index];
+	std::lock_guard<std::mutex> lock(self.mutex);
+	if (self.jobs.empty()) {
+		return false;
+	}
+	job = self.jobs.front();
+	self.jobs.pop_front();
+	return true;
+}
+
+bool WorkStealingScheduler::steal(int index, int& job) {
+	const int count = workers();
+	for (int offset = 1; offset < count; ++offset) {
+		Worker& victim = *m_workers[(index + offset) % count];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+		if (!victim.jobs.empty()) {
+			job = victim.jobs.back();
+			victim.jobs.pop_back();
+			return true;
+		}
+	}
+	return false;
+}
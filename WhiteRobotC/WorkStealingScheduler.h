@@ -0,0 +1,89 @@
+/****************************************************************************************
+* Project		:	AlgoTrading Jorge, David, Camilo, Shanka
+* File			:	WorkStealingScheduler.h
+* Lenguaje		:	C++
+* License		:	Apache License Ver 2.0, www.apache.org/licenses/LICENSE-2.0
+* Description	:	Runs a set of independent jobs of uneven cost on the workers of a pool,
+*					idle workers steal pending jobs from the others.
+*
+* References	:	- B. Stroustrup: The C++ Programming Language (Fourth Edition).
+*					  Addison Wesley. Reading Mass. USA. May 2013. ISBN 0-321-56384-0.
+*					- R. D. Blumofe and C. E. Leiserson: Scheduling multithreaded
+*					  computations by work stealing. Journal of the ACM 46(5). 1999.
+* Other files	:	ThreadPool.h provides the threads.
+* Git Control	:	https://github.com/camiloblanco/WhiteRobotC
+* Author - Year	:	Sahenjit Paul - Camilo Blanco Vargas - Year: 2021
+* Mail - Web	:	shanks.p.95@gmail.com -:mail@camiloblanco.com
+****************************************************************************************/
+
+/****************************************************************************************
+*							#GUARDS #INCLUDES AND #CONSTANTS							*
+****************************************************************************************/
+
+#pragma once
+
+#include <iostream>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <functional>
+#include "ThreadPool.h"
+
+/****************************************************************************************
+*									CLASS DECLARATION									*
+****************************************************************************************/
+
+// Jobs 0..jobCount-1 are dealt in blocks, round robin, to one deque per worker. A worker
+// runs its own deque from the front, in increasing job order, and when it is empty steals
+// from the back of the other deques, where the jobs are furthest from being reached.
+class WorkStealingScheduler
+{
+
+public:
+
+	// Runs one job, worker is the index of the calling worker in [0, workers())
+	typedef std::function<void(int worker, int job)> Job;
+
+	//constructors
+
+	explicit WorkStealingScheduler(ThreadPool& pool);
+
+
+	//Getters
+
+	int workers() const { return static_cast<int>(m_workers.size()); }
+
+
+	//public member functions
+
+	// Returns when every job is done, rethrows the first exception of a job
+	void run(int jobCount, const Job& job);
+
+	// Jobs, steals, busy time and finishing time of every worker in the last run
+	void printUtilization(std::ostream& out) const;
+
+private:
+
+	// Jobs dealt to a worker at a time, neighbouring jobs stay on the same worker
+	static const int kBlockSize = 4;
+
+	struct Worker {
+		std::mutex mutex; // Guards jobs
+		std::deque<int> jobs; // Pending jobs, owner pops the front, thieves the back
+		int executed; // Jobs run by this worker in the last run
+		int stolen; // Of which taken from another deque
+		double busy; // Seconds spent running jobs
+		double finished; // Seconds from the start of the run to the last job done
+	};
+
+	void workerLoop(int index, const Job& job);
+
+	bool popOwn(int index, int& job);
+
+	bool steal(int index, int& job);
+
+	ThreadPool& m_pool; // Threads running the worker loops
+	std::vector<std::unique_ptr<Worker>> m_workers; // One per pool thread
+	double m_elapsed; // Seconds of the last run
+};